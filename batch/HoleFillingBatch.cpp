@@ -0,0 +1,431 @@
+#include "HoleFilling.h"
+#include "ObjLoader.h"
+#include "MeshStream.h"
+#include "HoleTriangulation.h"
+#include "PatchRefinement.h"
+#include "PatchFairing.h"
+#include "BroadPhase.h"
+#include "JobService.h"
+#include <chrono>
+#include <exception>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace vvr;
+
+static void PrintUsage()
+{
+    std::cout << "Usage: 3-Hole_Filling_Batch <obj1> <obj2> [options]"
+        << std::endl << "       3-Hole_Filling_Batch --scene <file> [--out prefix] [--weld eps] [--no-cache] [--stats] [--trace file]"
+        << std::endl << "       3-Hole_Filling_Batch --serve <manifest|-> [--workers n] [--queue n] [--meshes n] [--weld eps] [--no-cache] [--stats] [--trace file]"
+        << std::endl
+        << std::endl << "'--shift1 x y z' => SHIFT OF FIRST OBJECT (default 1.5 0 0)"
+        << std::endl << "'--shift2 x y z' => SHIFT OF SECOND OBJECT (default -1.5 0 0)"
+        << std::endl << "'--size s'       => RESIZE BOTH OBJECTS BEFORE SHIFT (default: obj units)"
+        << std::endl << "'--keep 1|2'     => OBJECT TO KEEP FOR HOLE DETECTION (default 1)"
+        << std::endl << "'--weld eps'     => WELD VERTICES CLOSER THAN EPS (default 0: same position)"
+        << std::endl << "'--out prefix'   => OUTPUT PREFIX (default 'out')"
+        << std::endl << "'--fill'         => FILL THE HOLES (WRITES prefix_filled.obj)"
+        << std::endl << "'--refine'       => FILL AND REFINE THE PATCHES TO THE MESH DENSITY"
+        << std::endl << "'--fair 1|2'     => REFINE AND FAIR THE PATCHES (1: LAPLACIAN, 2: BI-LAPLACIAN)"
+        << std::endl << "'--no-cache'     => DO NOT READ/WRITE THE .hfcache FILES"
+        << std::endl << "'--stream dir'   => OUT-OF-CORE MODE, CHUNK FILES IN dir"
+        << std::endl << "'--memory mb'    => MEMORY TARGET FOR LOADED CHUNKS IN STREAM MODE (default 256)"
+        << std::endl << "'--stats'        => PRINT STAGE COUNTERS AND TIMERS"
+        << std::endl << "'--trace file'   => WRITE CHROME TRACE EVENT JSON"
+        << std::endl
+        << std::endl << "'--scene file'   => N-BODY SCENE, ONE '<obj> [x y z]' PER LINE (WRITES prefix_<n>.obj)"
+        << std::endl
+        << std::endl << "'--serve file'   => JOB SERVICE, ONE '<obj1> <obj2> <out> [keep [x1 y1 z1 x2 y2 z2]]' PER LINE ('-': STDIN)"
+        << std::endl << "'--workers n'    => JOBS RUNNING AT THE SAME TIME (default: hardware threads)"
+        << std::endl << "'--queue n'      => MAXIMUM QUEUED JOBS (default 64)"
+        << std::endl << "'--meshes n'     => MAXIMUM CACHED MESHES (default 16)"
+        << std::endl << std::endl;
+}
+
+// Skhnh me polla montela: broad phase (sweep and prune), narrow phase mono sta
+// zeugh pou epikalyptontai, afairesh twn temnomenwn trigwnwn kai cleaning
+static int RunScene(const string& file, const string& out, int use_cache, int stats, const string& trace)
+{
+    vector<SceneBody> bodies;
+    LoadScene(file, bodies, use_cache);
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    vector<int> order;
+    vector<pair<int, int> > pairs;
+    vector<vector<pair<int, int> > > hits;
+    int colliding = CollideScene(bodies, order, pairs, hits);
+    double collision_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    vector<char> touched;
+    int erased = EraseSceneCollisions(bodies, pairs, hits, touched);
+    int teeth = CleanScene(bodies, touched);
+    double cleaning_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    for (int b = 0; b < bodies.size(); b++)
+    {
+        vector<vec> baked;
+        BakeTransform(bodies[b].mesh.getVertices(), bodies[b].transform, baked);
+
+        ostringstream name;
+        name << out << "_" << b << ".obj";
+        WriteObj(name.str(), baked, bodies[b].mesh.getTriangles());
+    }
+
+    std::cout << "Bodies:        " << bodies.size()
+        << std::endl << "AABB pairs:    " << pairs.size()
+        << std::endl << "Colliding:     " << colliding
+        << std::endl;
+
+    for (int p = 0; p < pairs.size(); p++)
+    {
+        std::cout << "    " << pairs[p].first << " - " << pairs[p].second << ": "
+            << hits[p].size() << " triangle pairs" << std::endl;
+    }
+
+    std::cout << "Removed:       " << erased << " (collision) + " << teeth << " (teeth)"
+        << std::endl
+        << std::endl << "CollideScene:  " << collision_ms << " ms"
+        << std::endl << "Cleaning:      " << cleaning_ms << " ms"
+        << std::endl;
+
+    if (stats)
+    {
+        std::cout << std::endl;
+        PrintStats(std::cout);
+    }
+
+    if (!trace.empty()) WriteTrace(trace);
+    return 0;
+}
+
+// Ypiresia douleiwn: oi grammes tou manifest (h tou stdin) mpainoun sthn oura
+// kathws diabazontai kai ka8e apotelesma typwnetai molis teleiwsei h douleia
+static int RunServe(const string& file, int workers, int max_queue, int max_meshes, int use_cache, int stats, const string& trace)
+{
+    ifstream manifest;
+    string dir;
+
+    if (file != "-")
+    {
+        manifest.open(file.c_str());
+        if (!manifest) throw string("Cannot open manifest: ") + file;
+
+        size_t slash = file.find_last_of("/\\");
+        if (slash != string::npos) dir = file.substr(0, slash + 1);
+    }
+
+    istream& in = (file == "-") ? std::cin : manifest;
+
+    MeshCache cache(max_meshes, use_cache);
+    JobService service(workers, max_queue, cache, [](const MeshJobResult& result) {
+        PrintJobResult(std::cout, result);
+    });
+
+    string line;
+    int id = 0;
+
+    while (getline(in, line))
+    {
+        MeshJob job;
+
+        try {
+            if (!ParseJob(line, dir, job)) continue;
+        }
+        catch (std::string exc) {
+            cerr << exc << endl;
+            continue;
+        }
+
+        job.id = id++;
+        service.Submit(job);
+    }
+
+    service.Finish();
+
+    std::cout << std::endl;
+    PrintServiceMetrics(std::cout, service.Metrics(), cache);
+
+    if (stats)
+    {
+        std::cout << std::endl;
+        PrintStats(std::cout);
+    }
+
+    if (!trace.empty()) WriteTrace(trace);
+    return service.Metrics().failed ? 1 : 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    vec shift1(1.5, 0, 0);
+    vec shift2(-1.5, 0, 0);
+    float size = 0;
+    int keep = 1;
+    int placed = 0;
+    string out = "out";
+    int stats = 0;
+    int use_cache = 1;
+    int fill = 0;
+    int refine = 0;
+    int fair = 0;
+    string stream;
+    float memory = 256;
+    string trace;
+    int scene = string(argv[1]) == "--scene";
+    int serve = string(argv[1]) == "--serve";
+    int workers = 0;
+    int max_queue = 64;
+    int max_meshes = 16;
+
+    for (int i = 3; i < argc; i++)
+    {
+        string arg = argv[i];
+
+        if (arg == "--shift1" && i + 3 < argc)
+        {
+            shift1 = vec(atof(argv[i + 1]), atof(argv[i + 2]), atof(argv[i + 3]));
+            placed = 1;
+            i += 3;
+        }
+        else if (arg == "--shift2" && i + 3 < argc)
+        {
+            shift2 = vec(atof(argv[i + 1]), atof(argv[i + 2]), atof(argv[i + 3]));
+            placed = 1;
+            i += 3;
+        }
+        else if (arg == "--size" && i + 1 < argc) size = atof(argv[++i]);
+        else if (arg == "--keep" && i + 1 < argc)
+        {
+            keep = atoi(argv[++i]);
+            if (keep != 1 && keep != 2)
+            {
+                PrintUsage();
+                return 1;
+            }
+            placed = 1;
+        }
+        else if (arg == "--weld" && i + 1 < argc) weld_epsilon = atof(argv[++i]);
+        else if (arg == "--out" && i + 1 < argc) out = argv[++i];
+        else if (arg == "--stats") stats = 1;
+        else if (arg == "--no-cache") use_cache = 0;
+        else if (arg == "--fill") fill = 1;
+        else if (arg == "--refine") fill = refine = 1;
+        else if (arg == "--fair" && i + 1 < argc)
+        {
+            fair = atoi(argv[++i]);
+            if (fair != FAIR_LAPLACIAN && fair != FAIR_BILAPLACIAN)
+            {
+                PrintUsage();
+                return 1;
+            }
+            fill = refine = 1;
+        }
+        else if (arg == "--stream" && i + 1 < argc) stream = argv[++i];
+        else if (arg == "--memory" && i + 1 < argc) memory = atof(argv[++i]);
+        else if (arg == "--trace" && i + 1 < argc) trace = argv[++i];
+        else if (arg == "--workers" && serve && i + 1 < argc) workers = atoi(argv[++i]);
+        else if (arg == "--queue" && serve && i + 1 < argc) max_queue = atoi(argv[++i]);
+        else if (arg == "--meshes" && serve && i + 1 < argc) max_meshes = atoi(argv[++i]);
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    EnableStats(stats || !trace.empty());
+
+    // H skhnh exei tis metatopiseis sto arxeio kai den kanei gemisma
+    if (scene && (!stream.empty() || size > 0 || fill || placed))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (scene)
+    {
+        try {
+            return RunScene(argv[2], out, use_cache, stats, trace);
+        }
+        catch (std::string exc) {
+            cerr << exc << endl;
+            return 1;
+        }
+        catch (std::exception& exc) {
+            cerr << exc.what() << endl;
+            return 1;
+        }
+    }
+
+    // H ypiresia pairnei ta montela, tis metatopiseis kai to keep apo to manifest
+    if (serve)
+    {
+        if (!stream.empty() || size > 0 || fill || placed)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        try {
+            return RunServe(argv[2], workers, max_queue, max_meshes, use_cache, stats, trace);
+        }
+        catch (std::string exc) {
+            cerr << exc << endl;
+            return 1;
+        }
+        catch (std::exception& exc) {
+            cerr << exc.what() << endl;
+            return 1;
+        }
+    }
+
+    // To streaming den fortwnei to montelo, opote den ginetai resize
+    if (!stream.empty() && size > 0)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        if (!stream.empty())
+        {
+            vector<vvr::LineSeg3D> edges, loops;
+            vector<int> loop_ends;
+            int kept = 0;
+            int collided = RunStreamPipeline(argv[1], argv[2], shift1, shift2, keep, stream + "/stream",
+                (size_t)(memory * 1024 * 1024), out + "_cleaned.obj", edges, loops, loop_ends, kept);
+
+            WriteEdges(out + "_holes.obj", edges);
+            WriteLoops(out + "_loops.obj", loops, loop_ends);
+
+            std::cout << "Collision:     " << (collided ? "yes" : "no")
+                << std::endl << "Triangles:     " << kept
+                << std::endl << "Hole edges:    " << edges.size()
+                << std::endl << "Hole loops:    " << loop_ends.size()
+                << std::endl;
+
+            if (stats)
+            {
+                std::cout << std::endl;
+                PrintStats(std::cout);
+            }
+
+            if (!trace.empty()) WriteTrace(trace);
+            return 0;
+        }
+
+        vvr::Mesh model_1, model_2;
+        LoadObj(argv[1], model_1, 0, use_cache);
+        LoadObj(argv[2], model_2, 0, use_cache);
+
+        if (size > 0)
+        {
+            model_1.setBigSize(size);
+            model_2.setBigSize(size);
+            model_1.update();
+            model_2.update();
+        }
+
+        SetUp(model_1.getVertices(), shift1);
+        SetUp(model_2.getVertices(), shift2);
+
+        vector<vvr::LineSeg3D> edges, loops;
+        vector<int> loop_ends;
+        PipelineTimes times;
+        int collided = RunPipeline(model_1, model_2, keep, edges, loops, loop_ends, times);
+
+        vvr::Mesh& kept = (keep == 2) ? model_2 : model_1;
+        WriteObj(out + "_cleaned.obj", kept.getVertices(), kept.getTriangles());
+        WriteEdges(out + "_holes.obj", edges);
+        WriteLoops(out + "_loops.obj", loops, loop_ends);
+
+        int cleaned = kept.getTriangles().size();
+        int filled = 0;
+        int refined = 0;
+        double fill_ms = 0;
+        double refine_ms = 0;
+        double fair_ms = 0;
+        FairingCache fairing;
+
+        if (fill)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            EdgeAdjacency adj;
+            vector<int> patch_ends;
+            BuildEdgeAdjacency(kept.getTriangles(), adj);
+            filled = FillHoles(kept.getTriangles(), adj, loops, loop_ends, patch_ends);
+            fill_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+            if (refine)
+            {
+                start = std::chrono::high_resolution_clock::now();
+                refined = RefineHoles(kept.getTriangles(), cleaned, patch_ends);
+                filled = kept.getTriangles().size() - cleaned;
+                refine_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            }
+
+            if (fair)
+            {
+                start = std::chrono::high_resolution_clock::now();
+                FairHoles(kept.getTriangles(), cleaned, patch_ends, fair, fairing);
+                fair_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            }
+
+            WriteObj(out + "_filled.obj", kept.getVertices(), kept.getTriangles());
+        }
+
+        std::cout << "Collision:     " << (collided ? "yes" : "no")
+            << std::endl << "Triangles:     " << cleaned
+            << std::endl << "Hole edges:    " << edges.size()
+            << std::endl << "Hole loops:    " << loop_ends.size()
+            << std::endl
+            << std::endl << "CalcAABB:      " << times.aabb << " ms"
+            << std::endl << "TestTriangles: " << times.collision << " ms"
+            << std::endl << "Cleaning:      " << times.cleaning << " ms"
+            << std::endl << "HoleTriangles: " << times.hole_tris << " ms"
+            << std::endl << "HoleEdges:     " << times.hole_edges << " ms"
+            << std::endl << "SortEdges:     " << times.hole_loops << " ms"
+            << std::endl;
+
+        if (fill)
+        {
+            std::cout << "FillHoles:     " << fill_ms << " ms (" << filled << " triangles)" << std::endl;
+            if (refine) std::cout << "RefineHoles:   " << refine_ms << " ms (" << refined << " vertices)" << std::endl;
+            if (fair) std::cout << "FairHoles:     " << fair_ms << " ms (" << fairing.iterations << " CG iterations)" << std::endl;
+        }
+
+        if (stats)
+        {
+            std::cout << std::endl;
+            PrintStats(std::cout);
+        }
+
+        if (!trace.empty()) WriteTrace(trace);
+    }
+    catch (std::string exc) {
+        cerr << exc << endl;
+        return 1;
+    }
+    catch (std::exception& exc) {
+        cerr << exc.what() << endl;
+        return 1;
+    }
+    catch (...)
+    {
+        cerr << "Unknown exception" << endl;
+        return 1;
+    }
+
+    return 0;
+}
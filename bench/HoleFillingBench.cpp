@@ -0,0 +1,246 @@
+#include "HoleFilling.h"
+#include "ObjLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+using namespace vvr;
+
+// Montela tou resources/obj, apo to mikrotero sto megalytero
+static const char* BENCH_MODELS[] = {
+    "polyhedron", "icosahedron", "cube", "bone", "flashlight", "Phone_v02",
+    "teapotMultiMesh", "suzanne", "vvrlab", "unicorn_low_low", "dragon_low_low",
+    "armadillo_low_low", "bunny_low", "unicorn_low", "dolphin", "b66_L2",
+    "pins", "hand2"
+};
+
+static const char* BENCH_STAGES[] = {
+    "CalcAABB", "TestTriangles", "Cleaning", "FindHoleTriangles", "FindHoleEdges", "SortEdges"
+};
+
+#define BENCH_MODEL_COUNT (sizeof(BENCH_MODELS) / sizeof(BENCH_MODELS[0]))
+#define BENCH_STAGE_COUNT (sizeof(BENCH_STAGES) / sizeof(BENCH_STAGES[0]))
+
+struct BenchResult
+{
+    string model;
+    int triangles;
+    int kept;
+    int hole_edges;
+    int hole_loops;
+    double min_ms[BENCH_STAGE_COUNT];
+    double median_ms[BENCH_STAGE_COUNT];
+};
+
+static void PrintUsage()
+{
+    std::cout << "Usage: 3-Hole_Filling_Bench [options]"
+        << std::endl
+        << std::endl << "'--dir path'   => OBJ DIRECTORY (default 'resources/obj/')"
+        << std::endl << "'--model name' => RUN ONLY THIS MODEL (can be repeated)"
+        << std::endl << "'--reps n'     => REPETITIONS PER MODEL (default 5)"
+        << std::endl << "'--size s'     => SIZE OF BOTH OBJECTS (default 10)"
+        << std::endl << "'--json file'  => WRITE RESULTS AS JSON"
+        << std::endl << "'--csv file'   => WRITE RESULTS AS CSV"
+        << std::endl << std::endl;
+}
+
+static double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Ektelesh twn stadiwn mia fora se antigrafa twn montelwn
+// To model_2 einai to idio montelo metatopismeno, opote panta temnontai
+static void RunOnce(const vvr::Mesh& base_1, const vvr::Mesh& base_2, double* ms, BenchResult& result)
+{
+    vvr::Mesh model_1 = base_1;
+    vvr::Mesh model_2 = base_2;
+    vvr::Box3D aabb_1, aabb_2;
+    vector<vvr::Triangle> holes;
+    vector<vvr::LineSeg3D> edges, loops;
+    vector<int> loop_ends;
+
+    vector<vvr::Triangle>& tri1 = model_1.getTriangles();
+    vector<vvr::Triangle>& tri2 = model_2.getTriangles();
+
+    // Ta stadia typwnoun mhnymata, ta krybontai gia na mhn metrane
+    std::streambuf* old = cout.rdbuf(0);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    CalcAABB(model_1.getVertices(), aabb_1);
+    CalcAABB(model_2.getVertices(), aabb_2);
+    int areColliding = TestAABBs(aabb_1, aabb_2);
+    ms[0] = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    if (areColliding) TestTriangles(tri2, tri1);
+    ms[1] = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    Cleaning(tri1, 1);
+    ms[2] = ElapsedMs(start);
+
+    // To FindHoleTriangles metraei kai to xtisimo tou adjacency
+    start = std::chrono::high_resolution_clock::now();
+    EdgeAdjacency adj;
+    BuildEdgeAdjacency(tri1, adj);
+    FindHoleTriangles(tri1, adj, holes, 1);
+    ms[3] = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    FindHoleEdges(tri1, adj, edges, 1);
+    ms[4] = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    SortEdges(edges, loops, loop_ends);
+    ms[5] = ElapsedMs(start);
+
+    cout.rdbuf(old);
+    cout.clear();
+
+    result.kept = tri1.size();
+    result.hole_edges = edges.size();
+    result.hole_loops = loop_ends.size();
+}
+
+static void WriteJson(const string& file, const vector<BenchResult>& results, int reps, float size)
+{
+    ofstream out(file.c_str());
+    if (!out) throw string("Cannot write ") + file;
+
+    out << "{\n  \"reps\": " << reps << ",\n  \"size\": " << size << ",\n  \"results\": [\n";
+
+    for (int r = 0; r < results.size(); r++)
+    {
+        const BenchResult& res = results[r];
+
+        out << "    {\"model\": \"" << res.model << "\", \"triangles\": " << res.triangles
+            << ", \"kept\": " << res.kept << ", \"hole_edges\": " << res.hole_edges
+            << ", \"hole_loops\": " << res.hole_loops << ", \"stages\": {";
+
+        for (int s = 0; s < BENCH_STAGE_COUNT; s++)
+        {
+            out << (s ? ", " : "") << "\"" << BENCH_STAGES[s] << "\": {\"min_ms\": " << res.min_ms[s]
+                << ", \"median_ms\": " << res.median_ms[s] << "}";
+        }
+
+        out << "}}" << (r + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    out << "  ]\n}\n";
+}
+
+static void WriteCsv(const string& file, const vector<BenchResult>& results)
+{
+    ofstream out(file.c_str());
+    if (!out) throw string("Cannot write ") + file;
+
+    out << "model,triangles,kept,hole_edges,hole_loops,stage,min_ms,median_ms\n";
+
+    for (int r = 0; r < results.size(); r++)
+    {
+        const BenchResult& res = results[r];
+
+        for (int s = 0; s < BENCH_STAGE_COUNT; s++)
+        {
+            out << res.model << "," << res.triangles << "," << res.kept << ","
+                << res.hole_edges << "," << res.hole_loops << "," << BENCH_STAGES[s] << ","
+                << res.min_ms[s] << "," << res.median_ms[s] << "\n";
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    string dir = "resources/obj/";
+    vector<string> models;
+    int reps = 5;
+    float size = 10;
+    string json, csv;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+
+        if (arg == "--dir" && i + 1 < argc) dir = argv[++i];
+        else if (arg == "--model" && i + 1 < argc) models.push_back(argv[++i]);
+        else if (arg == "--reps" && i + 1 < argc) reps = max(1, atoi(argv[++i]));
+        else if (arg == "--size" && i + 1 < argc) size = atof(argv[++i]);
+        else if (arg == "--json" && i + 1 < argc) json = argv[++i];
+        else if (arg == "--csv" && i + 1 < argc) csv = argv[++i];
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (!dir.empty() && dir[dir.size() - 1] != '/' && dir[dir.size() - 1] != '\\') dir += "/";
+    if (models.empty()) models.assign(BENCH_MODELS, BENCH_MODELS + BENCH_MODEL_COUNT);
+
+    // Sta8eroi metatopismoi (se klasma tou size) wste ta 2 antigrafa
+    // na epikalyptontai kata to miso kai ta apotelesmata na einai idia se ka8e ektelesh
+    vec shift1(0.25f * size, 0.05f * size, 0);
+    vec shift2(-0.25f * size, 0, 0.05f * size);
+
+    m_style_flag = FLAG_ERASE;
+
+    try {
+        vector<BenchResult> results;
+
+        for (int m = 0; m < models.size(); m++)
+        {
+            vvr::Mesh base_1;
+            LoadObj(dir + models[m] + ".obj", base_1, 0, 0);
+            base_1.setBigSize(size);
+            base_1.update();
+
+            vvr::Mesh base_2 = base_1;
+            SetUp(base_1.getVertices(), shift1);
+            SetUp(base_2.getVertices(), shift2);
+
+            BenchResult res;
+            res.model = models[m];
+            res.triangles = base_1.getTriangles().size();
+
+            vector<vector<double> > samples(BENCH_STAGE_COUNT);
+
+            for (int r = 0; r < reps; r++)
+            {
+                double ms[BENCH_STAGE_COUNT];
+                RunOnce(base_1, base_2, ms, res);
+
+                for (int s = 0; s < BENCH_STAGE_COUNT; s++) samples[s].push_back(ms[s]);
+            }
+
+            for (int s = 0; s < BENCH_STAGE_COUNT; s++)
+            {
+                sort(samples[s].begin(), samples[s].end());
+                res.min_ms[s] = samples[s][0];
+                res.median_ms[s] = samples[s][samples[s].size() / 2];
+            }
+
+            cout << res.model << " (" << res.triangles << " triangles, " << res.hole_loops << " loops)" << endl;
+            for (int s = 0; s < BENCH_STAGE_COUNT; s++)
+                cout << "    " << BENCH_STAGES[s] << ": " << res.median_ms[s] << " ms" << endl;
+
+            results.push_back(res);
+        }
+
+        if (!json.empty()) WriteJson(json, results, reps, size);
+        if (!csv.empty()) WriteCsv(csv, results);
+    }
+    catch (std::string exc) {
+        cerr << exc << endl;
+        return 1;
+    }
+    catch (...)
+    {
+        cerr << "Unknown exception" << endl;
+        return 1;
+    }
+
+    return 0;
+}
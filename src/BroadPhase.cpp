@@ -0,0 +1,245 @@
+#include "BroadPhase.h"
+#include "ObjLoader.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+// AABB tou kosmou apo to topiko AABB kai ton metasxhmatismo
+void UpdateBodyAABB(SceneBody& body)
+{
+    TransformAABB(body.local_aabb, body.transform, body.aabb);
+}
+
+// Sweep and prune sto x me elegxo y kai z mesw ths TestAABBs
+// To order einai h seira twn AABB apo thn prohgoumenh klhsh (h adeio)
+// Ta zeugh (a, b) exoun a < b kai einai taksinomhmena. Epistrefei to plh8os tous
+int SweepAndPrune(const std::vector<vvr::Box3D>& aabbs, std::vector<int>& order, std::vector<std::pair<int, int> >& pairs)
+{
+    StatTimer timer("SweepAndPrune");
+
+    int n = aabbs.size();
+    pairs.clear();
+
+    if (order.size() != n)
+    {
+        order.resize(n);
+        for (int i = 0; i < n; i++) order[i] = i;
+    }
+
+    // Insertion sort ws pros to elaxisto x (x2): sxedon grammiko otan h seira allazei ligo
+    for (int i = 1; i < n; i++)
+    {
+        int key = order[i];
+        int j = i - 1;
+
+        while (j >= 0 && aabbs[order[j]].x2 > aabbs[key].x2)
+        {
+            order[j + 1] = order[j];
+            j--;
+        }
+
+        order[j + 1] = key;
+    }
+
+    // Ta energa diasthmata einai osa den exoun teleiwsei prin to trexon
+    vector<int> active;
+
+    for (int i = 0; i < n; i++)
+    {
+        int b = order[i];
+
+        for (int k = 0; k < active.size(); )
+        {
+            if (aabbs[active[k]].x1 < aabbs[b].x2)
+            {
+                active[k] = active.back();
+                active.pop_back();
+            }
+            else k++;
+        }
+
+        for (int k = 0; k < active.size(); k++)
+        {
+            int a = active[k];
+            if (TestAABBs(aabbs[a], aabbs[b])) pairs.push_back(make_pair(min(a, b), max(a, b)));
+        }
+
+        active.push_back(b);
+    }
+
+    sort(pairs.begin(), pairs.end());
+
+    return pairs.size();
+}
+
+// Broad phase kai narrow phase gia ola ta montela ths skhnhs
+// To hits[p] einai ta zeugh trigwnwn tou pairs[p] (trigwno tou first, trigwno tou second).
+// Ta zeugh elegxontai parallhla (ena ana task, me seiriako FindCollisions),
+// ektos an yparxei mono ena, opote parallhlopoieitai to idio to FindCollisions
+// Epistrefei to plh8os twn zeugwn montelwn pou temnontai
+int CollideScene(std::vector<SceneBody>& bodies, std::vector<int>& order, std::vector<std::pair<int, int> >& pairs,
+    std::vector<std::vector<std::pair<int, int> > >& hits)
+{
+    StatTimer timer("CollideScene");
+
+    vector<vvr::Box3D> aabbs(bodies.size());
+    for (int b = 0; b < bodies.size(); b++) aabbs[b] = bodies[b].aabb;
+
+    SweepAndPrune(aabbs, order, pairs);
+    hits.assign(pairs.size(), vector<pair<int, int> >());
+
+    // Ta montela pou symmetexoun se zeugh: h cache tous (sto topiko systhma)
+    // ananewnetai edw mia fora, kai ta zeugh th diabazoun parallhla
+    vector<int> used;
+    vector<char> is_used(bodies.size(), 0);
+
+    for (int p = 0; p < pairs.size(); p++)
+    {
+        int ends[2] = { pairs[p].first, pairs[p].second };
+        for (int e = 0; e < 2; e++)
+        {
+            if (!is_used[ends[e]]) used.push_back(ends[e]);
+            is_used[ends[e]] = 1;
+        }
+    }
+
+    ThreadPool::Global().ParallelFor(used.size(), 1, [&](int thread, int first, int last) {
+        for (int u = first; u < last; u++)
+            UpdateCollisionCache(bodies[used[u]].mesh.getTriangles(), bodies[used[u]].version, bodies[used[u]].cache);
+    });
+
+    auto narrow = [&](int p, int parallel) {
+        SceneBody& a = bodies[pairs[p].first];
+        SceneBody& b = bodies[pairs[p].second];
+        FindCollisionsLocal(a.mesh.getTriangles(), a.transform, a.cache, b.mesh.getTriangles(), b.transform, b.cache, hits[p], parallel);
+    };
+
+    if (pairs.size() == 1) narrow(0, 1);
+    else
+    {
+        ThreadPool::Global().ParallelFor(pairs.size(), 1, [&](int thread, int first, int last) {
+            for (int p = first; p < last; p++) narrow(p, 0);
+        });
+    }
+
+    int colliding = 0;
+    for (int p = 0; p < hits.size(); p++)
+        if (!hits[p].empty()) colliding++;
+
+    return colliding;
+}
+
+// Afairesh twn temnomenwn trigwnwn olwn twn zeugwn
+// Ola ta zeugh shmadeyontai prwta (ta hits deixnoun sthn arxikh seira twn trigwnwn)
+// kai ka8e montelo symptyssetai mia fora. To touched[b] = 1 gia ta montela pou allaksan
+// Epistrefei to plh8os twn trigwnwn pou afaire8hkan
+int EraseSceneCollisions(std::vector<SceneBody>& bodies, std::vector<std::pair<int, int> >& pairs,
+    std::vector<std::vector<std::pair<int, int> > >& hits, std::vector<char>& touched)
+{
+    int n = bodies.size();
+    vector<vector<char> > removed(n);
+    touched.assign(n, 0);
+
+    for (int p = 0; p < pairs.size(); p++)
+    {
+        if (hits[p].empty()) continue;
+
+        int a = pairs[p].first, b = pairs[p].second;
+        if (removed[a].empty()) removed[a].assign(bodies[a].mesh.getTriangles().size(), 0);
+        if (removed[b].empty()) removed[b].assign(bodies[b].mesh.getTriangles().size(), 0);
+
+        MarkCollisions(hits[p], removed[a], removed[b]);
+        touched[a] = touched[b] = 1;
+    }
+
+    vector<int> erased(n, 0);
+
+    ThreadPool::Global().ParallelFor(n, 1, [&](int thread, int first, int last) {
+        for (int b = first; b < last; b++)
+        {
+            if (!touched[b]) continue;
+
+            vector<vvr::Triangle>& tris = bodies[b].mesh.getTriangles();
+            int before = tris.size();
+            erased[b] = before - CompactTriangles(tris, removed[b]);
+            bodies[b].version++;
+        }
+    });
+
+    int total = 0;
+    for (int b = 0; b < n; b++) total += erased[b];
+
+    return total;
+}
+
+// Afairesh twn "dontiwn" apo ta montela pou allaksan, parallhla (ena montelo ana task)
+int CleanScene(std::vector<SceneBody>& bodies, const std::vector<char>& touched)
+{
+    StatTimer timer("CleanScene");
+
+    vector<int> erased(bodies.size(), 0);
+
+    ThreadPool::Global().ParallelFor(bodies.size(), 1, [&](int thread, int first, int last) {
+        for (int b = first; b < last; b++)
+        {
+            if (!touched[b]) continue;
+
+            erased[b] = EraseTeethIncremental(bodies[b].mesh.getTriangles());
+            if (erased[b]) bodies[b].version++;
+        }
+    });
+
+    int total = 0;
+    for (int b = 0; b < bodies.size(); b++) total += erased[b];
+
+    return total;
+}
+
+// Fortwsh skhnhs apo arxeio: ka8e grammh "<obj> [x y z]" (metatopish tou montelou)
+// Oi sxetikes diadromes einai ws pros to fakelo tou arxeiou, oi grammes me # agnoountai
+void LoadScene(const std::string& file, std::vector<SceneBody>& bodies, int use_cache)
+{
+    ifstream in(file.c_str());
+    if (!in) throw string("Cannot open scene: ") + file;
+
+    string dir;
+    size_t slash = file.find_last_of("/\\");
+    if (slash != string::npos) dir = file.substr(0, slash + 1);
+
+    vector<string> names;
+    vector<vec> shifts;
+    string line;
+
+    while (getline(in, line))
+    {
+        istringstream ss(line);
+        string name;
+        if (!(ss >> name) || name[0] == '#') continue;
+
+        vec shift(0, 0, 0);
+        ss >> shift.x >> shift.y >> shift.z;
+
+        if (name[0] != '/' && !(name.size() > 1 && name[1] == ':')) name = dir + name;
+        names.push_back(name);
+        shifts.push_back(shift);
+    }
+
+    // To bodies den megalwnei meta th fortwsh, opote ta trigwna deixnoun panta stis koryfes tous
+    bodies.clear();
+    bodies.resize(names.size());
+
+    for (int b = 0; b < bodies.size(); b++)
+    {
+        SceneBody& body = bodies[b];
+        body.name = names[b];
+        LoadObj(names[b], body.mesh, &body.local_aabb, use_cache);
+        body.version++;
+
+        IdentityTransform(body.transform);
+        body.transform.translation = shifts[b];
+        UpdateBodyAABB(body);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <VVRScene/canvas.h>
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include "HoleFilling.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// Broad phase gia skhnes me polla montela (sweep and prune).
+// Ta AABB taksinomountai ws pros to elaxisto x kai ena sarwma me lista
+// energwn diasthmatwn dinei ola ta zeugh pou epikalyptontai se x, y kai z
+// (TestAABBs). H seira krataeitai metaksy twn klhsewn kai diorthwnetai me
+// insertion sort, opote otan ta montela kinountai ligo to kostos einai O(n + k).
+// Mono ta zeugh pou bgainoun pernane sto narrow phase (FindCollisionsLocal).
+
+// Ena montelo ths skhnhs me to topiko kai to AABB tou kosmou
+// kai ta dedomena tou narrow phase sto topiko systhma.
+// To version auksanetai se ka8e allagh twn trigwnwn tou montelou (CollisionCache)
+struct SceneBody
+{
+    std::string name;
+    vvr::Mesh mesh;
+    ModelTransform transform;
+    vvr::Box3D local_aabb;
+    vvr::Box3D aabb;
+    CollisionCache cache;
+    int version;
+
+    SceneBody() : version(0) {}
+};
+
+// Synarthseis broad phase
+void UpdateBodyAABB(SceneBody& body);
+int SweepAndPrune(const std::vector<vvr::Box3D>& aabbs, std::vector<int>& order, std::vector<std::pair<int, int> >& pairs);
+int CollideScene(std::vector<SceneBody>& bodies, std::vector<int>& order, std::vector<std::pair<int, int> >& pairs,
+    std::vector<std::vector<std::pair<int, int> > >& hits);
+int EraseSceneCollisions(std::vector<SceneBody>& bodies, std::vector<std::pair<int, int> >& pairs,
+    std::vector<std::vector<std::pair<int, int> > >& hits, std::vector<char>& touched);
+int CleanScene(std::vector<SceneBody>& bodies, const std::vector<char>& touched);
+void LoadScene(const std::string& file, std::vector<SceneBody>& bodies, int use_cache = 1);
@@ -0,0 +1,117 @@
+#include "EdgeAdjacency.h"
+#include "PipelineStats.h"
+
+using namespace std;
+
+// Kleidi akmhs xwris fora (h mikroterh koryfh sta panw 32 bits)
+uint64_t EdgeKey(uint32_t a, uint32_t b)
+{
+    if (a > b) std::swap(a, b);
+    return ((uint64_t)a << 32) | b;
+}
+
+// Kataskeyh tou eyrethriou me ena perasma twn trigwnwn
+// Ta trigwna me removed[i] != 0 menoun sto eyrethrio alla den metrane
+// Ola ta trigwna prepei na deixnoun sth idia lista koryfwn (vecList)
+void BuildEdgeAdjacency(vector<vvr::Triangle>& tris, EdgeAdjacency& adj, const vector<char>* removed)
+{
+    StatTimer timer("BuildEdgeAdjacency");
+
+    adj.vertex_ids.clear();
+    adj.vertices.clear();
+    adj.edge_ids.clear();
+    adj.face_vertices.resize(3 * tris.size());
+    adj.face_edges.resize(3 * tris.size());
+    adj.edge_count.clear();
+
+    if (!tris.empty()) WeldVertices(*tris[0].vecList, weld_epsilon, adj.vertex_ids, adj.vertices);
+
+    adj.edge_ids.reserve(2 * tris.size());
+
+    for (int i = 0; i < tris.size(); i++)
+    {
+        uint32_t* v = &adj.face_vertices[3 * i];
+        v[0] = adj.vertex_ids[tris[i].vi1];
+        v[1] = adj.vertex_ids[tris[i].vi2];
+        v[2] = adj.vertex_ids[tris[i].vi3];
+
+        // Pleures me th seira v1v2, v2v3, v1v3
+        uint32_t e[3][2] = { { v[0], v[1] }, { v[1], v[2] }, { v[0], v[2] } };
+
+        for (int k = 0; k < 3; k++)
+        {
+            auto it = adj.edge_ids.insert(make_pair(EdgeKey(e[k][0], e[k][1]), (int)adj.edge_count.size()));
+            if (it.second) adj.edge_count.push_back(0);
+
+            adj.face_edges[3 * i + k] = it.first->second;
+        }
+
+        // Ka8e trigwno metraei mia fora se ka8e akmh tou (akoma kai an einai ekfylismeno)
+        int* f = &adj.face_edges[3 * i];
+        adj.edge_count[f[0]]++;
+        if (f[1] != f[0]) adj.edge_count[f[1]]++;
+        if (f[2] != f[0] && f[2] != f[1]) adj.edge_count[f[2]]++;
+    }
+
+    // Trigwna ana akmh (counting sort me bash ta edge_count)
+    adj.edge_offsets.assign(adj.edge_count.size() + 1, 0);
+    for (int e = 0; e < adj.edge_count.size(); e++)
+        adj.edge_offsets[e + 1] = adj.edge_offsets[e] + adj.edge_count[e];
+
+    adj.edge_faces.resize(adj.edge_offsets.back());
+    vector<int> fill(adj.edge_offsets.begin(), adj.edge_offsets.end() - 1);
+
+    for (int i = 0; i < tris.size(); i++)
+    {
+        const int* f = &adj.face_edges[3 * i];
+        adj.edge_faces[fill[f[0]]++] = i;
+        if (f[1] != f[0]) adj.edge_faces[fill[f[1]]++] = i;
+        if (f[2] != f[0] && f[2] != f[1]) adj.edge_faces[fill[f[2]]++] = i;
+    }
+
+    adj.removed.assign(tris.size(), 0);
+
+    if (removed)
+    {
+        for (int i = 0; i < tris.size(); i++)
+            if ((*removed)[i]) RemoveFace(adj, i);
+    }
+}
+
+// H akmh ab (enwmena ids) h -1 an den yparxei
+int FindEdge(const EdgeAdjacency& adj, uint32_t a, uint32_t b)
+{
+    auto e = adj.edge_ids.find(EdgeKey(a, b));
+    if (e == adj.edge_ids.end()) return -1;
+
+    return e->second;
+}
+
+// Plh8os trigwnwn pou periexoun thn akmh ab (enwmena ids)
+int EdgeCount(const EdgeAdjacency& adj, uint32_t a, uint32_t b)
+{
+    int e = FindEdge(adj, a, b);
+    if (e < 0) return 0;
+
+    return adj.edge_count[e];
+}
+
+// Metrhsh geitonikwn trigwnwn (ta trigwna ektos tou t stis 3 akmes tou)
+int AdjacentCount(const EdgeAdjacency& adj, int t)
+{
+    return adj.edge_count[adj.face_edges[3 * t]]
+        + adj.edge_count[adj.face_edges[3 * t + 1]]
+        + adj.edge_count[adj.face_edges[3 * t + 2]] - 3;
+}
+
+// To trigwno t den metraei pleon stis akmes tou (soft delete)
+void RemoveFace(EdgeAdjacency& adj, int t)
+{
+    if (adj.removed[t]) return;
+    adj.removed[t] = 1;
+
+    const int* f = &adj.face_edges[3 * t];
+    adj.edge_count[f[0]]--;
+    if (f[1] != f[0]) adj.edge_count[f[1]]--;
+    if (f[2] != f[0] && f[2] != f[1]) adj.edge_count[f[2]]--;
+}
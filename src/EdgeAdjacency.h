@@ -0,0 +1,39 @@
+#pragma once
+
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include "MeshWeld.h"
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+// Eyrethrio akmwn -> trigwnwn tou montelou
+// To edge_count krataei posa (energa) trigwna periexoun ka8e akmh,
+// enw ta edge_faces den allazoun me thn RemoveFace
+struct EdgeAdjacency
+{
+    // Enwmenes koryfes (welding me weld_epsilon): koryfh i tou montelou -> vertex_ids[i]
+    // kai ta trigwna ws 3 ids, wste oi sygkriseis na ginontai me akeraious
+    std::vector<uint32_t> vertex_ids;
+    std::vector<vec> vertices;
+    std::vector<uint32_t> face_vertices;
+
+    std::unordered_map<uint64_t, int> edge_ids;
+    std::vector<int> face_edges;
+    std::vector<int> edge_count;
+
+    // Trigwna ana akmh: edge_faces[edge_offsets[e]..edge_offsets[e + 1])
+    std::vector<int> edge_offsets;
+    std::vector<int> edge_faces;
+
+    // Trigwna pou exoun afaire8ei (tombstones), xwris na allazei h seira twn allwn
+    std::vector<char> removed;
+};
+
+// Synarthseis geitniashs
+uint64_t EdgeKey(uint32_t a, uint32_t b);
+void BuildEdgeAdjacency(std::vector<vvr::Triangle>& tris, EdgeAdjacency& adj, const std::vector<char>* removed = 0);
+int FindEdge(const EdgeAdjacency& adj, uint32_t a, uint32_t b);
+int EdgeCount(const EdgeAdjacency& adj, uint32_t a, uint32_t b);
+int AdjacentCount(const EdgeAdjacency& adj, int t);
+void RemoveFace(EdgeAdjacency& adj, int t);
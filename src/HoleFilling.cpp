@@ -0,0 +1,1218 @@
+#include "HoleFilling.h"
+#include "ThreadPool.h"
+#include "RobustPredicates.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+
+using namespace std;
+using namespace vvr;
+
+// Metablhtes elegxou
+int m_style_flag;
+
+
+// // // // // //
+// Movement Related Functions
+//
+
+// Metatopizei to montelo kata orismenh metabolh
+void SetUp(std::vector<vec>& vertices, const vec& shift)
+{
+    for (int i = 0; i < vertices.size(); i++)
+        vertices[i] += shift;
+}
+
+// Metatopish pou antistoixei sta belakia pou exoun paty8ei
+vec ArrowShift(vvr::ArrowDir dir, int modif)
+{
+    vec disp(0, 0, 0);
+
+    if (modif)
+    {
+        if (dir == UP) disp.z -= 1;
+        else if (dir == DOWN) disp.z += 1;
+    }
+
+    else
+    {
+        if (dir == UP) disp.y += 1;
+        else if (dir == DOWN) disp.y -= 1;
+        else if (dir == LEFT) disp.x -= 1;
+        else if (dir == RIGHT) disp.x += 1;
+    }
+
+    return disp;
+}
+
+// Metatopizei to montelo analoga me ta belakia pou exoun paty8ei
+void Displace(std::vector<vec>& vertices, vvr::ArrowDir dir, int modif)
+{
+    vec disp = ArrowShift(dir, modif);
+    if (disp.x != 0 || disp.y != 0 || disp.z != 0) SetUp(vertices, disp);
+}
+
+void IdentityTransform(ModelTransform& t)
+{
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++) t.rotation[i][j] = (i == j) ? 1.0f : 0.0f;
+
+    t.translation = vec(0, 0, 0);
+}
+
+// Metakinhsh me ta belakia: allazei mono o metasxhmatismos, O(1)
+void DisplaceTransform(ModelTransform& t, vvr::ArrowDir dir, int modif)
+{
+    t.translation += ArrowShift(dir, modif);
+}
+
+vec TransformPoint(const ModelTransform& t, const vec& p)
+{
+    const float (*r)[3] = t.rotation;
+
+    return vec(r[0][0] * p.x + r[0][1] * p.y + r[0][2] * p.z + t.translation.x,
+               r[1][0] * p.x + r[1][1] * p.y + r[1][2] * p.z + t.translation.y,
+               r[2][0] * p.x + r[2][1] * p.y + r[2][2] * p.z + t.translation.z);
+}
+
+// Metasxhmatismos apo to topiko systhma tou from sto topiko systhma tou to
+// p_to = R_to^T (R_from p + t_from - t_to)
+ModelTransform RelativeTransform(const ModelTransform& to, const ModelTransform& from)
+{
+    ModelTransform rel;
+
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+        {
+            rel.rotation[i][j] = 0;
+            for (int k = 0; k < 3; k++) rel.rotation[i][j] += to.rotation[k][i] * from.rotation[k][j];
+        }
+
+    vec d = from.translation - to.translation;
+    rel.translation = vec(to.rotation[0][0] * d.x + to.rotation[1][0] * d.y + to.rotation[2][0] * d.z,
+                          to.rotation[0][1] * d.x + to.rotation[1][1] * d.y + to.rotation[2][1] * d.z,
+                          to.rotation[0][2] * d.x + to.rotation[1][2] * d.y + to.rotation[2][2] * d.z);
+
+    return rel;
+}
+
+// O metasxhmatismos san pinakas gia th zwgrafikh tou montelou
+math::float3x4 TransformMatrix(const ModelTransform& t)
+{
+    const float (*r)[3] = t.rotation;
+
+    return math::float3x4(r[0][0], r[0][1], r[0][2], t.translation.x,
+                          r[1][0], r[1][1], r[1][2], t.translation.y,
+                          r[2][0], r[2][1], r[2][2], t.translation.z);
+}
+
+// Oi koryfes sto systhma tou kosmou, gia thn e3agwgh tou montelou
+void BakeTransform(const std::vector<vec>& vertices, const ModelTransform& t, std::vector<vec>& baked)
+{
+    baked.resize(vertices.size());
+
+    for (int i = 0; i < vertices.size(); i++)
+        baked[i] = TransformPoint(t, vertices[i]);
+}
+
+vvr::LineSeg3D TransformSegment(const ModelTransform& t, const vvr::LineSeg3D& seg)
+{
+    vec a = TransformPoint(t, vec(seg.x1, seg.y1, seg.z1));
+    vec b = TransformPoint(t, vec(seg.x2, seg.y2, seg.z2));
+
+    vvr::LineSeg3D moved = seg;
+    moved.x1 = a.x; moved.y1 = a.y; moved.z1 = a.z;
+    moved.x2 = b.x; moved.y2 = b.y; moved.z2 = b.z;
+
+    return moved;
+}
+
+// // // // // //
+
+
+
+
+// // // // // //
+// AABB Related Functions
+//
+
+// Ypologismos AABB
+void CalcAABB(std::vector<vec>& vertices, vvr::Box3D &aabb)
+{
+    StatTimer timer("CalcAABB");
+
+    double max_x = vertices[0].x;
+    double max_y = vertices[0].y;
+    double max_z = vertices[0].z;
+    double min_x = vertices[0].x;
+    double min_y = vertices[0].y;
+    double min_z = vertices[0].z;
+
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        if (vertices[i].x > max_x) max_x = vertices[i].x;
+        if (vertices[i].y > max_y) max_y = vertices[i].y;
+        if (vertices[i].z > max_z) max_z = vertices[i].z;
+
+        if (vertices[i].x < min_x) min_x = vertices[i].x;
+        if (vertices[i].y < min_y) min_y = vertices[i].y;
+        if (vertices[i].z < min_z) min_z = vertices[i].z;
+    }
+
+    aabb.x1 = max_x;
+    aabb.y1 = max_y;
+    aabb.z1 = max_z;
+
+    aabb.x2 = min_x;
+    aabb.y2 = min_y;
+    aabb.z2 = min_z;
+}
+
+// AABB tou metasxhmatismenou montelou apo to topiko AABB, O(1)
+// To kentro metaferetai kai oi hmi-diastaseis ginontai |R| * e
+void TransformAABB(const vvr::Box3D& local, const ModelTransform& t, vvr::Box3D& aabb)
+{
+    vec center((local.x1 + local.x2) / 2, (local.y1 + local.y2) / 2, (local.z1 + local.z2) / 2);
+    vec extent((local.x1 - local.x2) / 2, (local.y1 - local.y2) / 2, (local.z1 - local.z2) / 2);
+
+    vec c = TransformPoint(t, center);
+    float e[3];
+
+    for (int i = 0; i < 3; i++)
+    {
+        const float* r = t.rotation[i];
+        e[i] = fabs(r[0]) * extent.x + fabs(r[1]) * extent.y + fabs(r[2]) * extent.z;
+    }
+
+    aabb.x1 = c.x + e[0];
+    aabb.y1 = c.y + e[1];
+    aabb.z1 = c.z + e[2];
+
+    aabb.x2 = c.x - e[0];
+    aabb.y2 = c.y - e[1];
+    aabb.z2 = c.z - e[2];
+}
+
+// Draw AABB analoga me to an yparxei collision
+void DrawAABB(vvr::Box3D m_aabb, int collide)
+{
+    if (collide) m_aabb.setColour(Colour::red);
+    else m_aabb.setColour(Colour::black);
+
+    m_aabb.setTransparency(1);
+    m_aabb.draw();
+}
+
+// AABB collision Detection
+int TestAABBs(vvr::Box3D a, vvr::Box3D b)
+{
+    STAT_ADD(STAT_AABB_TESTS, 1);
+
+    // Den yparxei tomh an den yparxei epikalypsh se kapoion a3ona
+    if (a.x1 < b.x2 || a.x2 > b.x1) return 0;
+    if (a.y1 < b.y2 || a.y2 > b.y1) return 0;
+    if (a.z1 < b.z2 || a.z2 > b.z1) return 0;
+
+    // Tomh an yparxei epikalypsh kai stous 3 a3ones
+    return 1;
+}
+
+//
+// // // // // // 
+
+
+
+
+// // // // // //
+// Triangle Intersection, Colouring and Removal Related Functions
+//
+
+// Elegxos enos batch trigwnwn [begin, end) tou tri_a me ta trigwna tou tri_b
+// pou briskei to dentro bvh_b. O SIMD elegxos epipedwn aporriptei ta perissotera
+// zeugh kai mono ta ypoloipa pernane apo thn (symmetrikh) TestTriTri, mia fora to ka8e zeugos.
+// Ta zeugh (a, b) pou temnontai mpainoun sto hits
+static void TestTriangleBatch(const TriangleBVH& bvh_b, const TriangleSoA& soa_a, const TriangleSoA& soa_b, float tolerance,
+    int begin, int end, vector<int>& candidates, vector<pair<int, int> >& hits)
+{
+    for (int i = begin; i < end; i++)
+    {
+        float min[3] = { soa_a.minx[i], soa_a.miny[i], soa_a.minz[i] };
+        float max[3] = { soa_a.maxx[i], soa_a.maxy[i], soa_a.maxz[i] };
+        QueryBVH(bvh_b, min, max, candidates);
+
+        if (candidates.empty()) continue;
+
+        int count = FilterTriTri(soa_a, i, soa_b, &candidates[0], candidates.size(), tolerance, &candidates[0]);
+        STAT_ADD(STAT_PREFILTER_REJECTS, candidates.size() - count);
+
+        for (int k = 0; k < count; k++)
+        {
+            int j = candidates[k];
+
+            if (TestTriTri(soa_a, i, soa_b, j)) hits.push_back(make_pair(i, j));
+        }
+    }
+}
+
+// Dedomena enos thread gia ton elegxo sto topiko systhma: ta fylla tou allou
+// BVH pou temnei to fyllo, oi metaferomenes koryfes kai to SoA enos fyllou
+struct LocalScratch
+{
+    vector<int> leaves;
+    vector<int> candidates;
+    vector<vec> moved;
+    TriangleSoA soa;
+};
+
+// Elegxos twn fyllwn [begin, end) tou bvh_a me to bvh_b, to opoio einai sto
+// topiko systhma tou b (relative: apo to b sto a). Ta AABB twn kombwn tou bvh_b
+// metaferontai sto systhma tou a kata to query kai mono ta trigwna twn fyllwn
+// pou temnontai metaferontai (se SoA enos fyllou). Meta to AABB twn trigwnwn
+// ta zeugh pernane apo ton SIMD elegxo epipedwn kai thn TestTriTri
+static void TestLeafBatch(const TriangleBVH& bvh_a, const TriangleSoA& soa_a, const TriangleBVH& bvh_b, const MeshView& tri_b,
+    const ModelTransform& relative, float tolerance, const vector<int>& leaves_a, int begin, int end,
+    LocalScratch& scratch, vector<pair<int, int> >& hits)
+{
+    for (int l = begin; l < end; l++)
+    {
+        const BVHNode& leaf_a = bvh_a.nodes[leaves_a[l]];
+        QueryBVHLeaves(bvh_b, relative.rotation, relative.translation, leaf_a.min, leaf_a.max, scratch.leaves);
+
+        for (int m = 0; m < scratch.leaves.size(); m++)
+        {
+            const BVHNode& leaf_b = bvh_b.nodes[scratch.leaves[m]];
+            const int* ids_b = &bvh_b.tri_ids[leaf_b.first];
+
+            scratch.moved.resize(3 * leaf_b.count);
+            for (int k = 0; k < leaf_b.count; k++)
+            {
+                TriangleView t = tri_b[ids_b[k]];
+                scratch.moved[3 * k] = TransformPoint(relative, t.v1());
+                scratch.moved[3 * k + 1] = TransformPoint(relative, t.v2());
+                scratch.moved[3 * k + 2] = TransformPoint(relative, t.v3());
+            }
+
+            const TriangleSoA& soa_b = scratch.soa;
+            BuildTriangleSoA(&scratch.moved[0], leaf_b.count, scratch.soa);
+            scratch.candidates.resize(leaf_b.count);
+
+            for (int a = leaf_a.first; a < leaf_a.first + leaf_a.count; a++)
+            {
+                int i = bvh_a.tri_ids[a];
+                int count = 0;
+
+                for (int k = 0; k < leaf_b.count; k++)
+                {
+                    if (soa_b.maxx[k] < soa_a.minx[i] || soa_b.minx[k] > soa_a.maxx[i]) continue;
+                    if (soa_b.maxy[k] < soa_a.miny[i] || soa_b.miny[k] > soa_a.maxy[i]) continue;
+                    if (soa_b.maxz[k] < soa_a.minz[i] || soa_b.minz[k] > soa_a.maxz[i]) continue;
+                    scratch.candidates[count++] = k;
+                }
+
+                STAT_ADD(STAT_AABB_TESTS, leaf_b.count);
+                if (count == 0) continue;
+
+                int* candidates = &scratch.candidates[0];
+                int kept = FilterTriTri(soa_a, i, soa_b, candidates, count, tolerance, candidates);
+                STAT_ADD(STAT_PREFILTER_REJECTS, count - kept);
+
+                for (int k = 0; k < kept; k++)
+                    if (TestTriTri(soa_a, i, soa_b, candidates[k])) hits.push_back(make_pair(i, ids_b[candidates[k]]));
+            }
+        }
+    }
+}
+
+// Ananewsh ths cache tou montelou an allakse h ekdosh tou (h to plh8os twn
+// koryfwn kai twn trigwnwn). Epistrefei 1 an 3anaftiax8hke
+int UpdateCollisionCache(const MeshView& tris, int version, CollisionCache& cache)
+{
+    if (cache.valid && cache.version == version && cache.vertex_count == tris.vertex_count &&
+        cache.triangle_count == tris.size()) return 0;
+
+    BuildBVH(tris, cache.bvh);
+    BuildTriangleSoA(tris, cache.soa);
+    cache.version = version;
+    cache.vertex_count = tris.vertex_count;
+    cache.triangle_count = tris.size();
+    cache.valid = 1;
+    cache.built++;
+
+    return 1;
+}
+
+// Eyresh twn zeugwn trigwnwn (i tou tri1, j tou tri2) pou temnontai.
+// Ta BVH kai ta SoA ftiaxnontai proswrina, blepe thn ekdosh me CollisionCache
+int FindCollisions(const MeshView& tri1, const MeshView& tri2, vector<pair<int, int> >& hits, int parallel)
+{
+    CollisionCache cache1, cache2;
+    return FindCollisions(tri1, cache1, tri2, cache2, hits, parallel);
+}
+
+// Eyresh twn zeugwn trigwnwn (i tou tri1, j tou tri2) pou temnontai.
+// To tri1 elegxetai se batches parallhla, me ta zeugh pou temnontai se
+// lista ana thread. H TestTriTri einai symmetrikh, opote ka8e zeugos elegxetai
+// mia fora kai h idia lista dinei ta trigwna pou afairountai kai apo ta 2 montela. Oi listes enwnontai taksinomhmenes (idio apotelesma
+// me opoiodhpote plh8os threads). Me parallel == 0 olo trexei sto thread
+// pou kalei (gia klhseis mesa apo task tou pool).
+// Ta paragomena dedomena ka8e montelou erxontai apo thn cache tou, thn opoia
+// ananewnei o idiokthths tou montelou (UpdateCollisionCache). Mia cache pou den
+// exei ftiax8ei akoma ftiaxnetai edw. Epistrefei to plh8os twn zeugwn
+int FindCollisions(const MeshView& tri1, CollisionCache& cache1, const MeshView& tri2, CollisionCache& cache2,
+    vector<pair<int, int> >& hits, int parallel)
+{
+    StatTimer timer("FindCollisions");
+
+    hits.clear();
+
+    // Dentra AABB wste na elegxontai mono ta zeugh me epikalyptomena AABB
+    if (!cache1.valid) UpdateCollisionCache(tri1, 0, cache1);
+    if (!cache2.valid) UpdateCollisionCache(tri2, 0, cache2);
+
+    const TriangleBVH& bvh2 = cache2.bvh;
+    const TriangleSoA& soa1 = cache1.soa;
+    const TriangleSoA& soa2 = cache2.soa;
+    float tolerance = TriTriTolerance(soa1, soa2);
+
+    ThreadPool& pool = ThreadPool::Global();
+    vector<vector<int> > candidates(pool.Size());
+    vector<vector<pair<int, int> > > thread_hits(pool.Size());
+
+    if (parallel)
+    {
+        pool.ParallelFor(tri1.size(), 64, [&](int thread, int begin, int end) {
+            TestTriangleBatch(bvh2, soa1, soa2, tolerance, begin, end, candidates[thread], thread_hits[thread]);
+        });
+    }
+    else
+    {
+        TestTriangleBatch(bvh2, soa1, soa2, tolerance, 0, tri1.size(), candidates[0], thread_hits[0]);
+    }
+
+    for (int t = 0; t < thread_hits.size(); t++)
+        hits.insert(hits.end(), thread_hits[t].begin(), thread_hits[t].end());
+
+    sort(hits.begin(), hits.end());
+
+    return hits.size();
+}
+
+// Collision sto topiko systhma tou tri1, xwris na allazei kanena montelo.
+// Ta hits einai idia me ths FindCollisions sta metasxhmatismena montela
+int FindCollisionsLocal(const MeshView& tri1, const ModelTransform& t1, const MeshView& tri2,
+    const ModelTransform& t2, vector<pair<int, int> >& hits, int parallel)
+{
+    CollisionCache cache1, cache2;
+    return FindCollisionsLocal(tri1, t1, cache1, tri2, t2, cache2, hits, parallel);
+}
+
+// Opws h FindCollisionsLocal, me ta dedomena ka8e montelou (sto topiko tou systhma)
+// apo thn cache tou, thn opoia ananewnei o idiokthths tou (UpdateCollisionCache),
+// opote otan kineitai mono o metasxhmatismos den 3anaftiaxnetai tipota.
+// Ta fylla tou BVH tou tri1 elegxontai parallhla me to BVH tou tri2, tou opoiou ta
+// AABB metaferontai sto systhma tou tri1 kata to query. Mono ta trigwna tou tri2
+// sta fylla pou temnontai metaferontai, mia fora ana zeugos fyllwn
+int FindCollisionsLocal(const MeshView& tri1, const ModelTransform& t1, CollisionCache& cache1,
+    const MeshView& tri2, const ModelTransform& t2, CollisionCache& cache2, vector<pair<int, int> >& hits, int parallel)
+{
+    StatTimer timer("FindCollisions");
+
+    hits.clear();
+
+    if (tri1.empty() || tri2.empty()) return 0;
+
+    if (!cache1.valid) UpdateCollisionCache(tri1, 0, cache1);
+    if (!cache2.valid) UpdateCollisionCache(tri2, 0, cache2);
+
+    ModelTransform relative = RelativeTransform(t1, t2);
+
+    // Megisto |syntetagmenh| tou tri2 sto systhma tou tri1: |R p| <= sqrt(3) |p|,
+    // me peri8wrio gia th stroggylopoihsh tou R kai tou TransformPoint
+    const vec& t = relative.translation;
+    float scale2 = 1.001f * (1.7320508f * cache2.soa.scale + std::max(fabs(t.x), std::max(fabs(t.y), fabs(t.z))));
+    float tolerance = TriTriTolerance(std::max(cache1.soa.scale, scale2));
+
+    const TriangleBVH& bvh1 = cache1.bvh;
+    vector<int> leaves1;
+    for (int n = 0; n < bvh1.nodes.size(); n++)
+        if (bvh1.nodes[n].count > 0) leaves1.push_back(n);
+
+    ThreadPool& pool = ThreadPool::Global();
+    vector<LocalScratch> scratch(parallel ? pool.Size() : 1);
+    vector<vector<pair<int, int> > > thread_hits(scratch.size());
+
+    if (parallel)
+    {
+        pool.ParallelFor(leaves1.size(), 16, [&](int thread, int begin, int end) {
+            TestLeafBatch(bvh1, cache1.soa, cache2.bvh, tri2, relative, tolerance, leaves1, begin, end, scratch[thread], thread_hits[thread]);
+        });
+    }
+    else
+    {
+        TestLeafBatch(bvh1, cache1.soa, cache2.bvh, tri2, relative, tolerance, leaves1, 0, leaves1.size(), scratch[0], thread_hits[0]);
+    }
+
+    for (int h = 0; h < thread_hits.size(); h++)
+        hits.insert(hits.end(), thread_hits[h].begin(), thread_hits[h].end());
+
+    sort(hits.begin(), hits.end());
+
+    return hits.size();
+}
+
+// Xrwmatismos temnomenwn trigwnwn
+// Me t1/t2 ta trigwna zwgrafizontai sth 8esh tou metasxhmatismenou montelou
+void DrawCollisions(vector<vvr::Triangle>& tri1, vector<vvr::Triangle>& tri2, vector<pair<int, int> >& hits,
+    const ModelTransform* t1, const ModelTransform* t2)
+{
+    ModelTransform identity;
+    IdentityTransform(identity);
+    if (!t1) t1 = &identity;
+    if (!t2) t2 = &identity;
+
+    for (int h = 0; h < hits.size(); h++)
+    {
+        const vvr::Triangle& a = tri1[hits[h].first];
+        const vvr::Triangle& b = tri2[hits[h].second];
+        math::Triangle ta(TransformPoint(*t1, a.v1()), TransformPoint(*t1, a.v2()), TransformPoint(*t1, a.v3()));
+        math::Triangle tb(TransformPoint(*t2, b.v1()), TransformPoint(*t2, b.v2()), TransformPoint(*t2, b.v3()));
+        math2vvr(ta, vvr::Colour::darkGreen).draw();
+        math2vvr(tb, vvr::Colour::darkRed).draw();
+    }
+}
+
+// Shmadeyei (tombstone) ta temnomena trigwna kai twn 2 montelwn
+void MarkCollisions(vector<pair<int, int> >& hits, vector<char>& removed1, vector<char>& removed2)
+{
+    for (int h = 0; h < hits.size(); h++)
+    {
+        removed1[hits[h].first] = 1;
+        removed2[hits[h].second] = 1;
+    }
+}
+
+// Afairesh twn temnomenwn trigwnwn kai twn 2 montelwn
+void EraseCollisions(vector<vvr::Triangle>& tri1, vector<vvr::Triangle>& tri2, vector<pair<int, int> >& hits)
+{
+    vector<char> removed1(tri1.size(), 0);
+    vector<char> removed2(tri2.size(), 0);
+
+    MarkCollisions(hits, removed1, removed2);
+    CompactTriangles(tri1, removed1);
+    CompactTriangles(tri2, removed2);
+}
+
+// Elegxos tomhs twn trigwnwn twn 2 montelwn
+// Xrwmatismos kai afairesh analoga me to m_style_flag
+int TestTriangles(vector<vvr::Triangle>& tri1, vector<vvr::Triangle>& tri2)
+{
+    vector<pair<int, int> > hits;
+    FindCollisions(tri1, tri2, hits);
+
+    if (m_style_flag & FLAG_SHOW_TRIANGLES) DrawCollisions(tri1, tri2, hits);
+
+    if (!hits.empty() && (m_style_flag & FLAG_ERASE))
+    {
+        EraseCollisions(tri1, tri2, hits);
+        return 1;
+    }
+
+    return 0;
+}
+
+// Tmhma tomhs tou tri me to epipedo apo tis apostaseis (dist) kai ta proshma (sign) twn koryfwn.
+// Shmeia tomhs einai oi koryfes pou briskontai sto epipedo kai oi akmes me koryfes se
+// anti8etes meries. To t ypologizetai apo tis apostaseis, me elegxo gia mhdeniko paronomasth
+static vvr::LineSeg3D PlaneTriangleSegment(const vec* p, const float* dist, const int* sign)
+{
+    vec points[2];
+    int count = 0;
+
+    for (int k = 0; k < 3 && count < 2; k++)
+    {
+        int j = (k + 1) % 3;
+
+        if (sign[k] == 0)
+        {
+            points[count++] = p[k];
+        }
+        else if (sign[k] * sign[j] < 0)
+        {
+            float denom = dist[k] - dist[j];
+            float t = (denom != 0) ? dist[k] / denom : 0.5f;
+            t = max(0.0f, min(1.0f, t));
+
+            points[count++] = p[k] + t * (p[j] - p[k]);
+        }
+    }
+
+    if (count == 0) return LineSeg3D();
+    if (count == 1) points[1] = points[0];
+
+    return LineSeg3D(points[0].x, points[0].y, points[0].z, points[1].x, points[1].y, points[1].z);
+}
+
+// Elegxos tomhs 2 trigwnwn
+// H 8esh twn koryfwn tou tri2 ws pros to epipedo tou tri1 bgainei apo to Orient3D,
+// opote oi sxedon sto idio epipedo periptwseis den dinoun la8os proshmo
+int TestTriTri(TriangleView tri1, TriangleView tri2)
+{
+    int sign[3];
+    int side = TriangleSides(tri1, tri2, sign);
+
+    STAT_ADD(STAT_TRITRI_CALLS, 1);
+
+    if (side == 0)
+    {
+        STAT_ADD(STAT_PLANE_REJECTS, 1);
+    }
+    else if (side == 1)
+    {
+        Plane plane1(tri1.v1(), tri1.v2(), tri1.v3());
+        float dist[3] = {
+            Dot(plane1.normal, tri2.v1()) - plane1.d,
+            Dot(plane1.normal, tri2.v2()) - plane1.d,
+            Dot(plane1.normal, tri2.v3()) - plane1.d
+        };
+
+        vec p[3] = { tri2.v1(), tri2.v2(), tri2.v3() };
+        LineSeg3D interLine = PlaneTriangleSegment(p, dist, sign);
+
+        if (SegInTriangle(tri1, interLine)) return 1;
+    }
+    // Diaxeirish eidikhs periptwshs
+    else if (side == 2)
+    {
+        STAT_ADD(STAT_COPLANAR_HITS, 1);
+
+        if (PointInTriangle(tri1, tri2.v1()) || PointInTriangle(tri1, tri2.v2()) || PointInTriangle(tri1, tri2.v3()))
+            return 1;
+        if (PointInTriangle(tri2, tri1.v1()) || PointInTriangle(tri2, tri1.v2()) || PointInTriangle(tri2, tri1.v3()))
+            return 1;
+    }
+
+    return 0;
+}
+
+// Koryfes tou trigwnou i apo ta SoA
+static void SoAVertices(const TriangleSoA& soa, int i, vec* p)
+{
+    p[0] = vec(soa.ax[i], soa.ay[i], soa.az[i]);
+    p[1] = vec(soa.bx[i], soa.by[i], soa.bz[i]);
+    p[2] = vec(soa.cx[i], soa.cy[i], soa.cz[i]);
+}
+
+// Proshma twn koryfwn q ws pros to epipedo tou trigwnou p (Orient3D).
+// Epistrefei 0 an einai oles apo thn idia meria (den yparxei tomh)
+static int PlaneSigns(const vec* p, const vec* q, int* sign)
+{
+    for (int k = 0; k < 3; k++) sign[k] = Orient3D(p[0], p[1], p[2], q[k]);
+
+    if (sign[0] > 0 && sign[1] > 0 && sign[2] > 0) return 0;
+    if (sign[0] < 0 && sign[1] < 0 && sign[2] < 0) return 0;
+    return 1;
+}
+
+// Tmhma tomhs tou trigwnou p (sign ws pros to epipedo n, d) me to epipedo
+static LineSeg3D PlaneSegment(const vec* p, const int* sign, const vec& n, float d)
+{
+    float dist[3] = { Dot(n, p[0]) - d, Dot(n, p[1]) - d, Dot(n, p[2]) - d };
+    return PlaneTriangleSegment(p, dist, sign);
+}
+
+// Symmetrikos elegxos tomhs tou trigwnou i tou soa1 me to j tou soa2 (Moller).
+// Ta proshma kai twn dyo trigwnwn ws pros to epipedo tou allou bgainoun apo to
+// Orient3D, opote an kapoio brisketai olo apo th mia meria to zeugos aporriptetai
+// amesws. Alliws ta tmhmata tomhs ka8e trigwnou me to epipedo tou allou briskontai
+// sthn eytheia tomhs twn epipedwn kai ta trigwna temnontai an ta diasthmata tous
+// epikalyptontai. Dinei to idio apotelesma me TestTriTri(a, b) || TestTriTri(b, a)
+// me mia klhsh ana zeugos
+int TestTriTri(const TriangleSoA& soa1, int i, const TriangleSoA& soa2, int j)
+{
+    vec p1[3], p2[3];
+    SoAVertices(soa1, i, p1);
+    SoAVertices(soa2, j, p2);
+
+    STAT_ADD(STAT_TRITRI_CALLS, 1);
+
+    int sign2[3], sign1[3];
+    if (!PlaneSigns(p1, p2, sign2) || !PlaneSigns(p2, p1, sign1))
+    {
+        STAT_ADD(STAT_PLANE_REJECTS, 1);
+        return 0;
+    }
+
+    if (sign2[0] == 0 && sign2[1] == 0 && sign2[2] == 0)
+    {
+        STAT_ADD(STAT_COPLANAR_HITS, 1);
+
+        for (int k = 0; k < 3; k++)
+            if (PointInTriangle(soa1, i, p2[k])) return 1;
+        for (int k = 0; k < 3; k++)
+            if (PointInTriangle(soa2, j, p1[k])) return 1;
+
+        return 0;
+    }
+
+    vec n1(soa1.px[i], soa1.py[i], soa1.pz[i]);
+    vec n2(soa2.px[j], soa2.py[j], soa2.pz[j]);
+
+    // seg2: tomh tou trigwnou j me to epipedo tou i, seg1: antistrofa
+    LineSeg3D seg2 = PlaneSegment(p2, sign2, n1, soa1.pd[i]);
+    LineSeg3D seg1 = PlaneSegment(p1, sign1, n2, soa2.pd[j]);
+
+    vec dir = Cross(n1, n2);
+
+    // Sxedon parallhla epipeda: h eytheia tomhs den orizetai kala,
+    // opote ta akra elegxontai me barycentrikes syntetagmenes
+    if (dir.LengthSq() < 1e-12f)
+    {
+        if (PointInTriangle(soa1, i, vec(seg2.x1, seg2.y1, seg2.z1))) return 1;
+        if (PointInTriangle(soa1, i, vec(seg2.x2, seg2.y2, seg2.z2))) return 1;
+        if (PointInTriangle(soa2, j, vec(seg1.x1, seg1.y1, seg1.z1))) return 1;
+        if (PointInTriangle(soa2, j, vec(seg1.x2, seg1.y2, seg1.z2))) return 1;
+        return 0;
+    }
+
+    // Provolh twn tmhmatwn sthn eytheia tomhs
+    float a1 = Dot(dir, vec(seg1.x1, seg1.y1, seg1.z1));
+    float b1 = Dot(dir, vec(seg1.x2, seg1.y2, seg1.z2));
+    float a2 = Dot(dir, vec(seg2.x1, seg2.y1, seg2.z1));
+    float b2 = Dot(dir, vec(seg2.x2, seg2.y2, seg2.z2));
+    if (a1 > b1) swap(a1, b1);
+    if (a2 > b2) swap(a2, b2);
+
+    return (max(a1, a2) <= min(b1, b2));
+}
+
+// Sxetikh 8esh trigwnou ws pros to epipedo enos allou trigwnou me akribh proshma
+// To side[k] einai to Orient3D ths koryfhs k. Epistrefei 0 an to tri einai olo apo
+// th mia meria, 2 an einai sto idio epipedo kai 1 an to temnei
+int TriangleSides(TriangleView plane, TriangleView tri, int* side)
+{
+    const vec& a = plane.v1();
+    const vec& b = plane.v2();
+    const vec& c = plane.v3();
+
+    side[0] = Orient3D(a, b, c, tri.v1());
+    side[1] = Orient3D(a, b, c, tri.v2());
+    side[2] = Orient3D(a, b, c, tri.v3());
+
+    if (side[0] > 0 && side[1] > 0 && side[2] > 0) return 0;
+    else if (side[0] < 0 && side[1] < 0 && side[2] < 0) return 0;
+    else if (side[0] == 0 && side[1] == 0 && side[2] == 0) return 2;
+    else return 1;
+}
+
+// Elegxos an ena ey8ygrammo tmhma anhkei se trigwno
+int SegInTriangle(TriangleView tri, const vvr::LineSeg3D& line)
+{
+    vec p1(line.x1, line.y1, line.z1);
+    vec p2(line.x2, line.y2, line.z2);
+
+    // Elegxoyme an toulaxiston ena akro tou tmhmatos anhkei sto trigwno
+    int check1 = PointInTriangle(tri, p1);
+    int check2 = PointInTriangle(tri, p2);
+
+    if (check1 || check2) return 1;
+
+    return 0;
+}
+
+// Elegxos an ena shmeio anhkei sto trigwno mesw barycentrikwn syntetagmenwn
+int PointInTriangle(TriangleView tri, const vec& p)
+{
+    const vec& a = tri.v1();
+    const vec& b = tri.v2();
+    const vec& c = tri.v3();
+
+    float u, v, w;// Barycentric coordinates
+
+    vec v0 = b - a;
+    vec v1 = c - a;
+    vec v2 = p - a;
+
+    float d00 = Dot(v0, v0);
+    float d01 = Dot(v0, v1);
+    float d11 = Dot(v1, v1);
+    float d20 = Dot(v2, v0);
+    float d21 = Dot(v2, v1);
+
+    // Cramer
+    float denom = d00 * d11 - d01 * d01;
+
+    v = (d11 * d20 - d01 * d21) / denom;
+    w = (d00 * d21 - d01 * d20) / denom;
+    u = 1.0f - v - w;
+
+    return (v >= 0.0f && w >= 0.0f && (v + w) <= 1.0f);
+}
+
+// PointInTriangle gia to trigwno i twn SoA, me ta d00, d01, d11 kai denom apo thn cache
+int PointInTriangle(const TriangleSoA& soa, int i, const vec& p)
+{
+    vec a(soa.ax[i], soa.ay[i], soa.az[i]);
+    vec v0 = vec(soa.bx[i], soa.by[i], soa.bz[i]) - a;
+    vec v1 = vec(soa.cx[i], soa.cy[i], soa.cz[i]) - a;
+    vec v2 = p - a;
+
+    float d20 = Dot(v2, v0);
+    float d21 = Dot(v2, v1);
+
+    float v = (soa.d11[i] * d20 - soa.d01[i] * d21) / soa.denom[i];
+    float w = (soa.d00[i] * d21 - soa.d01[i] * d20) / soa.denom[i];
+
+    return (v >= 0.0f && w >= 0.0f && (v + w) <= 1.0f);
+}
+//
+// // // // // //
+
+
+
+
+// // // // // //
+// Hole Finding and Cleaning Related Functions
+//
+
+// Afairesh teeth me lista ergasiwn: otan afaireitai ena trigwno
+// 3anaelegxontai mono oi geitones tou. Dinei to idio teliko apotelesma
+// me thn epanalhpsh olwn twn trigwnwn mexri na mh bgainei allo, afou oi metrhseis mono meiwnontai.
+// Ta trigwna mono shmadeyontai sto adj.removed (soft delete).
+// Epistrefei to plh8os twn trigwnwn pou afaire8hkan
+int CleanTeeth(EdgeAdjacency& adj)
+{
+    StatTimer timer("CleanTeeth");
+
+    int faces = adj.removed.size();
+    vector<char> queued(faces, 0);
+    vector<int> work;
+
+    for (int i = 0; i < faces; i++)
+    {
+        if (!adj.removed[i] && AdjacentCount(adj, i) < 2)
+        {
+            work.push_back(i);
+            queued[i] = 1;
+        }
+    }
+
+    for (int w = 0; w < work.size(); w++)
+    {
+        int t = work[w];
+
+        RemoveFace(adj, t);
+
+        // Elegxos mono twn geitonwn tou t
+        for (int k = 0; k < 3; k++)
+        {
+            int e = adj.face_edges[3 * t + k];
+
+            for (int j = adj.edge_offsets[e]; j < adj.edge_offsets[e + 1]; j++)
+            {
+                int f = adj.edge_faces[j];
+
+                if (!queued[f] && !adj.removed[f] && AdjacentCount(adj, f) < 2)
+                {
+                    work.push_back(f);
+                    queued[f] = 1;
+                }
+            }
+        }
+    }
+
+    STAT_ADD(STAT_TEETH_ITERATIONS, work.size());
+
+    return work.size();
+}
+
+// Afairesh teeth me lista ergasiwn kai ena compaction sto telos
+int EraseTeethIncremental(vector<vvr::Triangle>& tris)
+{
+    EdgeAdjacency adj;
+    BuildEdgeAdjacency(tris, adj);
+
+    int removed = CleanTeeth(adj);
+    if (removed) CompactTriangles(tris, adj.removed);
+
+    return removed;
+}
+
+// Afairesh twn shmademenwn trigwnwn me ena stable perasma
+// Epistrefei to neo plh8os trigwnwn
+int CompactTriangles(vector<vvr::Triangle>& tris, const vector<char>& removed)
+{
+    int n = 0;
+
+    for (int i = 0; i < tris.size(); i++)
+        if (!removed[i]) tris[n++] = tris[i];
+
+    STAT_ADD(STAT_TRIANGLES_REMOVED, tris.size() - n);
+
+    tris.erase(tris.begin() + n, tris.end());
+    return n;
+}
+
+// Epanalhptikh afairesh teeth
+void Cleaning(vector<vvr::Triangle>& tris, int once)
+{
+    if (once)
+    {
+        StatTimer timer("Cleaning");
+
+        cout << "Finding and Cleaning Holes..." << endl;
+
+        EraseTeethIncremental(tris);
+    }
+}
+
+// Eyresh trigwnwn pou anhkoun se oph
+void FindHoleTriangles(vector<vvr::Triangle>& tris, const EdgeAdjacency& adj, vector<vvr::Triangle>& holes, int once)
+{
+    if (once)
+    {
+        StatTimer timer("FindHoleTriangles");
+
+        for (int i = 0; i < tris.size(); i++)
+        {
+            if (adj.removed[i]) continue;
+
+            int count = AdjacentCount(adj, i);
+
+            if (count == 2) holes.push_back(tris[i]);
+        }
+    }
+}
+
+// Entopismos oriakwn perioxwn
+// Oriakes einai oi akmes pou xrhsimopoiountai apo ena mono trigwno.
+// Ena perasma tou montelou, me tis metrhseis tou eyrethriou akmwn
+// Epistrefei to plh8os twn akmwn pou pros8e8hkan
+int CollectHoleEdges(vector<vvr::Triangle>& model, const EdgeAdjacency& adj, vector<vvr::LineSeg3D>& edges)
+{
+    int found = edges.size();
+
+    for (int i = 0; i < model.size(); i++)
+    {
+        if (adj.removed[i]) continue;
+
+        // Oi 8eseis twn enwmenwn koryfwn, wste oi akmes na tairiazoun sthn SortEdges
+        const uint32_t* f = &adj.face_vertices[3 * i];
+        vec v1 = adj.vertices[f[0]];
+        vec v2 = adj.vertices[f[1]];
+        vec v3 = adj.vertices[f[2]];
+
+        const int* e = &adj.face_edges[3 * i];
+
+        if (adj.edge_count[e[0]] == 1)
+        {
+            LineSeg3D edge(v1.x, v1.y, v1.z, v2.x, v2.y, v2.z, vvr::Colour::red);
+            edges.push_back(edge);
+
+        }
+        if (adj.edge_count[e[1]] == 1)
+        {
+            LineSeg3D edge(v2.x, v2.y, v2.z, v3.x, v3.y, v3.z, vvr::Colour::red);
+            edges.push_back(edge);
+        }
+        if (adj.edge_count[e[2]] == 1)
+        {
+            LineSeg3D edge(v1.x, v1.y, v1.z, v3.x, v3.y, v3.z, vvr::Colour::red);
+            edges.push_back(edge);
+        }
+    }
+
+    STAT_ADD(STAT_HOLE_EDGES, edges.size() - found);
+
+    return edges.size() - found;
+}
+
+// Entopismos twn akmwn opwn mia fora (opws sto scene)
+void FindHoleEdges(vector<vvr::Triangle>& model, const EdgeAdjacency& adj, vector<vvr::LineSeg3D>& edges, int once)
+{
+    if (once)
+    {
+        StatTimer timer("FindHoleEdges");
+
+        CollectHoleEdges(model, adj, edges);
+
+        cout << "Finished!\n" << endl;
+    }
+}
+
+// Sort gia na bre8ei ka8e oph 3exwrista
+// Oi akmes enwnontai se kleistous brogxous mesw ths antistoixias
+// koryfh -> akmes, opote ka8e akmh episkeptetai mia fora.
+// Sto indices mpainei h 8esh ths teleytaias akmhs ka8e brogxou sto sorted_edges.
+// Oi brogxoi einai apla kleista kommatia (ka8e koryfh mia fora), opote to
+// apotelesma den e3artatai apo th seira twn akmwn. Anoixtes alysides den mpainoun
+// sto sorted_edges. Epistrefei to plh8os twn akmwn pou den mphkan se brogxo
+int SortEdges(std::vector<vvr::LineSeg3D>& edges, std::vector<vvr::LineSeg3D>& sorted_edges, std::vector<int>& indices)
+{
+    StatTimer timer("SortEdges");
+
+    unordered_map<VertexKey, int, VertexKeyHash> vertex_ids;
+    vector<int> ends(2 * edges.size());
+
+    for (int i = 0; i < edges.size(); i++)
+    {
+        vec v1(edges[i].x1, edges[i].y1, edges[i].z1);
+        vec v2(edges[i].x2, edges[i].y2, edges[i].z2);
+
+        ends[2 * i] = vertex_ids.insert(make_pair(MakeVertexKey(v1), (int)vertex_ids.size())).first->second;
+        ends[2 * i + 1] = vertex_ids.insert(make_pair(MakeVertexKey(v2), (int)vertex_ids.size())).first->second;
+    }
+
+    // Akmes ana koryfh: vertex_edges[offsets[v]..offsets[v + 1])
+    vector<int> offsets(vertex_ids.size() + 1, 0);
+    for (int i = 0; i < ends.size(); i++) offsets[ends[i] + 1]++;
+    for (int v = 0; v < vertex_ids.size(); v++) offsets[v + 1] += offsets[v];
+
+    vector<int> vertex_edges(ends.size());
+    vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < ends.size(); i++) vertex_edges[fill[ends[i]]++] = i / 2;
+
+    vector<char> used(edges.size(), 0);
+    vector<int> degree(vertex_ids.size());
+    vector<int> leaves;
+    int loose = 0;
+
+    // Prwta afairountai oi kremasmenes alysides: oso yparxei koryfh me mia mono
+    // akmh, h akmh ayth den anhkei se brogxo
+    for (int v = 0; v < vertex_ids.size(); v++)
+    {
+        degree[v] = offsets[v + 1] - offsets[v];
+        if (degree[v] == 1) leaves.push_back(v);
+    }
+
+    while (!leaves.empty())
+    {
+        int v = leaves.back();
+        leaves.pop_back();
+        if (degree[v] != 1) continue;
+
+        for (int k = offsets[v]; k < offsets[v + 1]; k++)
+        {
+            int e = vertex_edges[k];
+            if (used[e]) continue;
+
+            used[e] = 1;
+            loose++;
+
+            int other = (ends[2 * e] == v) ? ends[2 * e + 1] : ends[2 * e];
+            degree[v]--;
+            if (--degree[other] == 1) leaves.push_back(other);
+            break;
+        }
+    }
+
+    // Oi kleistoi peripatoi xwrizontai sta shmeia pou pernane 3ana apo mia koryfh.
+    // To path krataei tis akmes me th fora tous (2 * akmh + flip, opote h akmh
+    // 3ekinaei apo thn ends[path[k]]) kai to position th 8esh ka8e koryfhs sto path
+    vector<int> path;
+    vector<int> position(vertex_ids.size(), -1);
+
+    auto emit = [&](int from) {
+        for (int k = from; k < path.size(); k++)
+        {
+            const LineSeg3D& e = edges[path[k] / 2];
+
+            if (path[k] % 2 == 0)
+                sorted_edges.push_back(e);
+            else
+                sorted_edges.push_back(LineSeg3D(e.x2, e.y2, e.z2, e.x1, e.y1, e.z1, vvr::Colour::red));
+        }
+
+        indices.push_back(sorted_edges.size() - 1);
+    };
+
+    for (int i = 0; i < edges.size(); i++)
+    {
+        if (used[i]) continue;
+
+        int current = ends[2 * i];
+        path.clear();
+        position[current] = 0;
+
+        for (;;)
+        {
+            int next = -1;
+
+            for (int k = offsets[current]; k < offsets[current + 1]; k++)
+            {
+                if (!used[vertex_edges[k]])
+                {
+                    next = vertex_edges[k];
+                    break;
+                }
+            }
+
+            // Adie3odo (p.x. koryfh me peritto plh8os akmwn): h teleytaia akmh den
+            // kleinei brogxo kai o peripatos synexizei apo thn arxh ths
+            if (next == -1)
+            {
+                if (path.empty()) break;
+
+                position[current] = -1;
+                current = ends[path.back()];
+                path.pop_back();
+                loose++;
+                continue;
+            }
+
+            used[next] = 1;
+            int flip = (ends[2 * next] != current);
+            path.push_back(2 * next + flip);
+            current = ends[2 * next + 1 - flip];
+
+            if (position[current] < 0)
+            {
+                position[current] = path.size();
+                continue;
+            }
+
+            // O peripatos ftanei 3ana sthn current: to kommati apo ekei einai brogxos
+            int from = position[current];
+            for (int k = from + 1; k < path.size(); k++)
+                position[ends[path[k]]] = -1;
+
+            emit(from);
+            path.resize(from);
+            position[current] = from;
+        }
+
+        position[current] = -1;
+    }
+
+    STAT_ADD(STAT_LOOSE_EDGES, loose);
+    return loose;
+}
+//
+// // // // // //
+
+
+
+
+// // // // // //
+// Headless Pipeline Related Functions
+//
+
+// Xronos se ms apo to start
+static double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Ektelesh olwn twn stadiwn (collision -> cleaning -> holes) mia fora
+// To keep dialegei poio montelo kratame (1 h 2), opws to keepObj sto scene
+int RunPipeline(vvr::Mesh& model_1, vvr::Mesh& model_2, int keep, vector<vvr::LineSeg3D>& edges, vector<vvr::LineSeg3D>& loops, vector<int>& loop_ends, PipelineTimes& times)
+{
+    StatTimer timer("RunPipeline");
+
+    vvr::Box3D aabb_1, aabb_2;
+    vector<vvr::Triangle> holes;
+    vector<pair<int, int> > hits;
+
+    vector<vvr::Triangle>& tri1 = model_1.getTriangles();
+    vector<vvr::Triangle>& tri2 = model_2.getTriangles();
+
+    // Ta stadia mono shmadeyoun ta trigwna pou afairountai
+    // kai ta montela symptyssontai mia fora sto telos
+    vector<char> removed1(tri1.size(), 0);
+    vector<char> removed2(tri2.size(), 0);
+
+    times.aabb = times.collision = times.cleaning = times.hole_tris = times.hole_edges = times.hole_loops = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    CalcAABB(model_1.getVertices(), aabb_1);
+    CalcAABB(model_2.getVertices(), aabb_2);
+    int areColliding = TestAABBs(aabb_1, aabb_2);
+    times.aabb = ElapsedMs(start);
+
+    if (areColliding)
+    {
+        start = std::chrono::high_resolution_clock::now();
+        FindCollisions(tri2, tri1, hits);
+        MarkCollisions(hits, removed2, removed1);
+        times.collision = ElapsedMs(start);
+    }
+
+    vector<vvr::Triangle>& kept = (keep == 2) ? tri2 : tri1;
+
+    start = std::chrono::high_resolution_clock::now();
+    cout << "Finding and Cleaning Holes..." << endl;
+    EdgeAdjacency adj;
+    BuildEdgeAdjacency(kept, adj, (keep == 2) ? &removed2 : &removed1);
+    CleanTeeth(adj);
+    times.cleaning = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    FindHoleTriangles(kept, adj, holes, 1);
+    times.hole_tris = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    FindHoleEdges(kept, adj, edges, 1);
+    times.hole_edges = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    SortEdges(edges, loops, loop_ends);
+    times.hole_loops = ElapsedMs(start);
+
+    if (keep == 2) removed2 = adj.removed;
+    else removed1 = adj.removed;
+
+    CompactTriangles(tri1, removed1);
+    CompactTriangles(tri2, removed2);
+
+    return !hits.empty();
+}
+
+// Apo8hkeysh montelou se arxeio obj
+void WriteObj(const std::string& file, std::vector<vec>& vertices, std::vector<vvr::Triangle>& tris)
+{
+    ofstream out(file.c_str());
+    if (!out) throw std::string("Cannot write file: ") + file;
+
+    for (int i = 0; i < vertices.size(); i++)
+        out << "v " << vertices[i].x << " " << vertices[i].y << " " << vertices[i].z << "\n";
+
+    for (int i = 0; i < tris.size(); i++)
+        out << "f " << tris[i].vi1 + 1 << " " << tris[i].vi2 + 1 << " " << tris[i].vi3 + 1 << "\n";
+}
+
+// Apo8hkeysh oriakwn pleurwn san grammes obj
+void WriteEdges(const std::string& file, std::vector<vvr::LineSeg3D>& edges)
+{
+    ofstream out(file.c_str());
+    if (!out) throw std::string("Cannot write file: ") + file;
+
+    for (int i = 0; i < edges.size(); i++)
+    {
+        out << "v " << edges[i].x1 << " " << edges[i].y1 << " " << edges[i].z1 << "\n";
+        out << "v " << edges[i].x2 << " " << edges[i].y2 << " " << edges[i].z2 << "\n";
+    }
+
+    for (int i = 0; i < edges.size(); i++)
+        out << "l " << 2 * i + 1 << " " << 2 * i + 2 << "\n";
+}
+
+// Apo8hkeysh twn brogxwn twn ophwn, mia grammh obj ana oph
+void WriteLoops(const std::string& file, std::vector<vvr::LineSeg3D>& loops, std::vector<int>& loop_ends)
+{
+    ofstream out(file.c_str());
+    if (!out) throw std::string("Cannot write file: ") + file;
+
+    for (int i = 0; i < loops.size(); i++)
+        out << "v " << loops[i].x1 << " " << loops[i].y1 << " " << loops[i].z1 << "\n";
+
+    int first = 0;
+    for (int h = 0; h < loop_ends.size(); h++)
+    {
+        out << "l";
+        for (int i = first; i <= loop_ends[h]; i++) out << " " << i + 1;
+        out << " " << first + 1 << "\n";
+        first = loop_ends[h] + 1;
+    }
+}
+//
+// // // // // //
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <VVRScene/canvas.h>
+#include <VVRScene/mesh.h>
+#include <VVRScene/utils.h>
+#include <MathGeoLib.h>
+#include "EdgeAdjacency.h"
+#include "MeshView.h"
+#include "PipelineStats.h"
+#include "TriangleBVH.h"
+#include "TriTriSimd.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define FLAG_SHOW_TRIANGLES  1
+#define FLAG_SHOW_WIRE       2
+#define FLAG_SHOW_SOLID      4
+#define FLAG_SHOW_NORMALS    8
+#define FLAG_CHANGE_OBJ     16
+#define FLAG_SHOW_AABB      32
+#define FLAG_ERASE          64
+#define FLAG_HIDE          128
+#define FLAG_FILL          256
+
+// Metablhth elegxou (koinh gia scene kai batch)
+extern int m_style_flag;
+
+// Rigid metasxhmatismos enos montelou: p = rotation * p_local + translation
+// Oi koryfes menoun sto topiko systhma tou montelou kai h metakinhsh allazei
+// mono ton metasxhmatismo (oi koryfes grafontai mono sthn e3agwgh)
+struct ModelTransform
+{
+    float rotation[3][3];
+    vec translation;
+};
+
+// Paragomena dedomena enos montelou gia to narrow phase: to BVH kai ta SoA
+// (epipeda, barycentrikh bash, AABB). Ftiaxnontai mia fora kai ksanaxrhsimopoiountai
+// apo oles tis klhseis ths FindCollisions. To version einai h ekdosh tou montelou
+// apo thn opoia ftiax8hke: o idiokthths tou montelou thn auksanei se ka8e allagh
+// twn koryfwn h twn trigwnwn (LoadObj, SetUp, CompactTriangles klp), opote o elegxos
+// einai O(1) kai h cache 3anaftiaxnetai mono otan allaksei to montelo.
+// Otan einai egkyrh h cache mono diabazetai, opote mporei na th moirazontai polla tasks
+struct CollisionCache
+{
+    int version;
+    int vertex_count;
+    int triangle_count;
+    int valid;
+    int built;
+    TriangleBVH bvh;
+    TriangleSoA soa;
+
+    CollisionCache() : version(0), vertex_count(0), triangle_count(0), valid(0), built(0) {}
+};
+
+// Xronoi ektelesh ka8e stadiou se ms
+struct PipelineTimes
+{
+    double aabb;
+    double collision;
+    double cleaning;
+    double hole_tris;
+    double hole_edges;
+    double hole_loops;
+};
+
+// Synarthseis ylopoihshs project
+void SetUp(std::vector<vec>& vertices, const vec& shift);
+void Displace(std::vector<vec>& vertices, vvr::ArrowDir dir, int modif);
+vec ArrowShift(vvr::ArrowDir dir, int modif);
+void IdentityTransform(ModelTransform& t);
+void DisplaceTransform(ModelTransform& t, vvr::ArrowDir dir, int modif);
+vec TransformPoint(const ModelTransform& t, const vec& p);
+ModelTransform RelativeTransform(const ModelTransform& to, const ModelTransform& from);
+math::float3x4 TransformMatrix(const ModelTransform& t);
+void BakeTransform(const std::vector<vec>& vertices, const ModelTransform& t, std::vector<vec>& baked);
+vvr::LineSeg3D TransformSegment(const ModelTransform& t, const vvr::LineSeg3D& seg);
+void CalcAABB(std::vector<vec>& vertices, vvr::Box3D& aabb);
+void TransformAABB(const vvr::Box3D& local, const ModelTransform& t, vvr::Box3D& aabb);
+void DrawAABB(vvr::Box3D m_aabb, int collide);
+int TestAABBs(vvr::Box3D aabb1, vvr::Box3D aabb2);
+int TestTriangles(std::vector<vvr::Triangle>& tri1, std::vector<vvr::Triangle>& tri2);
+int UpdateCollisionCache(const MeshView& tris, int version, CollisionCache& cache);
+int FindCollisions(const MeshView& tri1, const MeshView& tri2, std::vector<std::pair<int, int> >& hits, int parallel = 1);
+int FindCollisions(const MeshView& tri1, CollisionCache& cache1, const MeshView& tri2, CollisionCache& cache2,
+    std::vector<std::pair<int, int> >& hits, int parallel = 1);
+int FindCollisionsLocal(const MeshView& tri1, const ModelTransform& t1, const MeshView& tri2,
+    const ModelTransform& t2, std::vector<std::pair<int, int> >& hits, int parallel = 1);
+int FindCollisionsLocal(const MeshView& tri1, const ModelTransform& t1, CollisionCache& cache1,
+    const MeshView& tri2, const ModelTransform& t2, CollisionCache& cache2, std::vector<std::pair<int, int> >& hits, int parallel = 1);
+void DrawCollisions(std::vector<vvr::Triangle>& tri1, std::vector<vvr::Triangle>& tri2, std::vector<std::pair<int, int> >& hits,
+    const ModelTransform* t1 = 0, const ModelTransform* t2 = 0);
+void MarkCollisions(std::vector<std::pair<int, int> >& hits, std::vector<char>& removed1, std::vector<char>& removed2);
+void EraseCollisions(std::vector<vvr::Triangle>& tri1, std::vector<vvr::Triangle>& tri2, std::vector<std::pair<int, int> >& hits);
+int TriangleSides(TriangleView plane, TriangleView tri, int* side);
+int PointInTriangle(TriangleView tri, const vec& p);
+int PointInTriangle(const TriangleSoA& soa, int i, const vec& p);
+int SegInTriangle(TriangleView tri, const vvr::LineSeg3D& line);
+int TestTriTri(TriangleView tri1, TriangleView tri2);
+int TestTriTri(const TriangleSoA& soa1, int i, const TriangleSoA& soa2, int j);
+int EraseTeethIncremental(std::vector<vvr::Triangle>& tris);
+int CleanTeeth(EdgeAdjacency& adj);
+int CompactTriangles(std::vector<vvr::Triangle>& tris, const std::vector<char>& removed);
+void Cleaning(std::vector<vvr::Triangle>& tris, int once);
+void FindHoleTriangles(std::vector<vvr::Triangle>& tris, const EdgeAdjacency& adj, std::vector<vvr::Triangle>& holes, int once);
+int CollectHoleEdges(std::vector<vvr::Triangle>& model, const EdgeAdjacency& adj, std::vector<vvr::LineSeg3D>& edges);
+void FindHoleEdges(std::vector<vvr::Triangle>& model, const EdgeAdjacency& adj, std::vector<vvr::LineSeg3D>& edges, int once);
+int SortEdges(std::vector<vvr::LineSeg3D>& edges, std::vector<vvr::LineSeg3D>& sorted_edges, std::vector<int>& indices);
+
+// Headless pipeline (xwris VVR scene)
+int RunPipeline(vvr::Mesh& model_1, vvr::Mesh& model_2, int keep, std::vector<vvr::LineSeg3D>& edges, std::vector<vvr::LineSeg3D>& loops, std::vector<int>& loop_ends, PipelineTimes& times);
+void WriteObj(const std::string& file, std::vector<vec>& vertices, std::vector<vvr::Triangle>& tris);
+void WriteEdges(const std::string& file, std::vector<vvr::LineSeg3D>& edges);
+void WriteLoops(const std::string& file, std::vector<vvr::LineSeg3D>& loops, std::vector<int>& loop_ends);
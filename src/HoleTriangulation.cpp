@@ -0,0 +1,618 @@
+#include "HoleTriangulation.h"
+#include "HoleFilling.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+static float TriangleArea(const vec& a, const vec& b, const vec& c)
+{
+    return 0.5f * (b - a).Cross(c - a).Length();
+}
+
+// // // // // //
+// Trigwnopoihsh
+// // // // // //
+
+// Trigwnopoihsh elaxistou embadou (dynamic programming, O(n^3))
+// To W[i][j] einai to elaxisto embadon gia to polygwno i, i+1, ..., j
+// Ta trigwna (i, k, j) me i < k < j akolou8oun th fora tou polygwnou
+// Oi blocked diagwnies den mpainoun pote: epistrefei 0 (xwris trigwna)
+// an den yparxei trigwnopoihsh xwris aytes
+int MinWeightTriangulation(const std::vector<vec>& points, std::vector<int>& triangles, const BlockedDiagonal& blocked)
+{
+    int n = points.size();
+    if (n < 3) return 0;
+
+    vector<float> W(n * n, 0);
+    vector<int> K(n * n, -1);
+
+    for (int len = 2; len < n; len++)
+    {
+        for (int i = 0; i + len < n; i++)
+        {
+            int j = i + len;
+            float best = -1;
+
+            // H (0, n - 1) einai akmh ths ophs, oxi diagwnios
+            int diagonal = !(i == 0 && j == n - 1);
+
+            if (!(diagonal && blocked && blocked(i, j)))
+            {
+                for (int k = i + 1; k < j; k++)
+                {
+                    if (W[i * n + k] < 0 || W[k * n + j] < 0) continue;
+
+                    float w = W[i * n + k] + W[k * n + j] + TriangleArea(points[i], points[k], points[j]);
+
+                    if (best < 0 || w < best)
+                    {
+                        best = w;
+                        K[i * n + j] = k;
+                    }
+                }
+            }
+
+            W[i * n + j] = best;
+        }
+    }
+
+    if (K[n - 1] < 0) return 0;
+
+    // Anakataskeyh twn trigwnwn apo ta K
+    vector<pair<int, int> > stack;
+    stack.push_back(make_pair(0, n - 1));
+
+    while (!stack.empty())
+    {
+        int i = stack.back().first;
+        int j = stack.back().second;
+        stack.pop_back();
+
+        if (j - i < 2) continue;
+
+        int k = K[i * n + j];
+        triangles.push_back(i);
+        triangles.push_back(k);
+        triangles.push_back(j);
+
+        stack.push_back(make_pair(i, k));
+        stack.push_back(make_pair(k, j));
+    }
+
+    return 1;
+}
+
+// Ear clipping me priority queue enos polygwnou (deiktes sto points): se ka8e
+// bhma kobetai to egkyro ayti me th mikroterh eswterikh gwnia. Oi koryfes
+// probalontai sto epipedo tou polygwnou (kanoniko Newell) kai egkyro ayti einai
+// mia kyrth koryfh pou to trigwno ths den periexei kamia allh koryfh pou menei
+// kai h diagwnios ths den einai blocked. Meta apo ka8e kopsimo
+// 3anaelegxontai oi 2 geitones kai, an den meinei egkyro ayti, oles oi koryfes.
+// Epistrefei 0 an den yparxei egkyro ayti (p.x. h probolh temnei ton eayto ths),
+// me to polygwno pou emeine sto rest
+static int ClipEars(const vector<vec>& points, const vector<int>& poly, vector<int>& triangles,
+    const BlockedDiagonal& blocked, vector<int>& rest)
+{
+    int n = poly.size();
+    rest = poly;
+
+    // Kanoniko tou polygwnou (Newell)
+    vec normal(0, 0, 0);
+    for (int i = 0; i < n; i++)
+        normal += points[poly[i]].Cross(points[poly[(i + 1) % n]]);
+
+    float length = normal.Length();
+    if (length == 0) return 0;
+
+    // Bash (u, w) tou epipedou me u x w = kanoniko, opote oi kyrtes koryfes
+    // exoun 8etiko orient
+    vec axis = normal / length;
+    vec u = (fabs(axis.x) < 0.9f) ? vec(1, 0, 0).Cross(axis) : vec(0, 1, 0).Cross(axis);
+    u /= u.Length();
+    vec w = axis.Cross(u);
+
+    vector<double> px(n), py(n);
+    for (int i = 0; i < n; i++)
+    {
+        px[i] = points[poly[i]].Dot(u);
+        py[i] = points[poly[i]].Dot(w);
+    }
+
+    auto orient = [&](int a, int b, int c) {
+        return (px[b] - px[a]) * (py[c] - py[a]) - (py[b] - py[a]) * (px[c] - px[a]);
+    };
+
+    vector<int> prev(n), next(n), version(n, 0);
+    vector<char> clipped(n, 0);
+
+    for (int i = 0; i < n; i++)
+    {
+        prev[i] = (i + n - 1) % n;
+        next[i] = (i + 1) % n;
+    }
+
+    // To trigwno (prev, v, next) den periexei (oute sta oria tou) kamia allh
+    // koryfh pou menei. Oi koryfes sthn idia 8esh me mia gwnia agnoountai
+    auto empty = [&](int v) {
+        int a = prev[v], c = next[v];
+
+        for (int r = next[c]; r != a; r = next[r])
+        {
+            if ((px[r] == px[a] && py[r] == py[a]) || (px[r] == px[v] && py[r] == py[v]) || (px[r] == px[c] && py[r] == py[c]))
+                continue;
+
+            if (orient(a, v, r) >= 0 && orient(v, c, r) >= 0 && orient(c, a, r) >= 0) return 0;
+        }
+
+        return 1;
+    };
+
+    // Poiothta tou ayti sthn koryfh v (mikroterh = kalyterh), -1 an den einai egkyro
+    auto quality = [&](int v) {
+        vec a = points[poly[prev[v]]] - points[poly[v]];
+        vec b = points[poly[next[v]]] - points[poly[v]];
+        float la = a.Length(), lb = b.Length();
+
+        if (blocked && blocked(poly[prev[v]], poly[next[v]])) return -1.0f;
+
+        // Mhdenikh akmh: to ekfylismeno trigwno apla afairei th diplh koryfh
+        if (la == 0 || lb == 0) return 0.0f;
+        if (orient(prev[v], v, next[v]) <= 0 || !empty(v)) return -1.0f;
+
+        return acos(max(-1.0f, min(1.0f, a.Dot(b) / (la * lb))));
+    };
+
+    typedef pair<float, pair<int, int> > Ear;
+    priority_queue<Ear, vector<Ear>, greater<Ear> > ears;
+
+    auto push = [&](int v) {
+        float q = quality(v);
+        if (q >= 0) ears.push(make_pair(q, make_pair(v, version[v])));
+    };
+
+    for (int i = 0; i < n; i++) push(i);
+
+    int remaining = n;
+
+    while (remaining > 3)
+    {
+        // Ta aytia pou den htan egkyra mporei na egine meta to kopsimo allwn koryfwn
+        if (ears.empty())
+        {
+            for (int v = 0; v < n; v++)
+            {
+                if (clipped[v]) continue;
+
+                version[v]++;
+                push(v);
+            }
+
+            if (ears.empty())
+            {
+                rest.clear();
+
+                int start = 0;
+                while (clipped[start]) start++;
+
+                int v = start;
+                do
+                {
+                    rest.push_back(poly[v]);
+                    v = next[v];
+                } while (v != start);
+
+                return 0;
+            }
+        }
+
+        int v = ears.top().second.first;
+        int ver = ears.top().second.second;
+        ears.pop();
+
+        // H koryfh exei kopei h h poiothta ths exei allaksei
+        if (clipped[v] || ver != version[v]) continue;
+
+        int p = prev[v], q = next[v];
+        triangles.push_back(poly[p]);
+        triangles.push_back(poly[v]);
+        triangles.push_back(poly[q]);
+
+        clipped[v] = 1;
+        next[p] = q;
+        prev[q] = p;
+        remaining--;
+
+        version[p]++;
+        version[q]++;
+        push(p);
+        push(q);
+    }
+
+    // To teleytaio trigwno
+    for (int v = 0; v < n; v++)
+    {
+        if (clipped[v]) continue;
+
+        triangles.push_back(poly[prev[v]]);
+        triangles.push_back(poly[v]);
+        triangles.push_back(poly[next[v]]);
+        break;
+    }
+
+    return 1;
+}
+
+// Ear clipping olou tou polygwnou. An kapoio kommati den exei egkyro ayti,
+// xwrizetai sth mikroterh mh blocked diagwnio tou kai ta 2 kommatia
+// kobontai 3exwrista, to ka8e ena sto diko tou epipedo. O(n^2) xwris xwrismata
+// Epistrefei to plh8os twn xwrismatwn pou xreiasthkan, h -1 (xwris trigwna)
+// an ena kommati den exei oute egkyro ayti oute mh blocked diagwnio
+int EarClipping(const std::vector<vec>& points, std::vector<int>& triangles, const BlockedDiagonal& blocked)
+{
+    int n = points.size();
+    if (n < 3) return -1;
+
+    int added = triangles.size();
+
+    vector<vector<int> > work(1);
+    for (int i = 0; i < n; i++) work[0].push_back(i);
+
+    vector<int> poly, rest;
+    int splits = 0;
+
+    while (!work.empty())
+    {
+        poly.swap(work.back());
+        work.pop_back();
+
+        if (ClipEars(points, poly, triangles, blocked, rest)) continue;
+
+        int m = rest.size();
+        int best_i = -1, best_j = -1;
+        float best = 0;
+
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = i + 2; j < m; j++)
+            {
+                if (i == 0 && j == m - 1) continue;
+                if (blocked && blocked(rest[i], rest[j])) continue;
+
+                float d = (points[rest[i]] - points[rest[j]]).LengthSq();
+
+                if (best_i < 0 || d < best)
+                {
+                    best_i = i;
+                    best_j = j;
+                    best = d;
+                }
+            }
+        }
+
+        if (best_i < 0)
+        {
+            triangles.resize(added);
+            return -1;
+        }
+
+        vector<int> first(rest.begin() + best_i, rest.begin() + best_j + 1);
+        vector<int> second(rest.begin() + best_j, rest.end());
+        second.insert(second.end(), rest.begin(), rest.begin() + best_i + 1);
+
+        work.push_back(first);
+        work.push_back(second);
+        splits++;
+    }
+
+    return splits;
+}
+
+// // // // // //
+// Opes
+// // // // // //
+
+// Oi koryfes enos brogxou ws deiktes koryfwn tou montelou, me th fora pou
+// dinei sta nea trigwna ton idio prosanatolismo me to trigwno ths akmhs
+// Epistrefei 0 an o brogxos den antistoixei se akmes tou montelou
+static int LoopVertices(const EdgeAdjacency& adj,
+    const unordered_map<VertexKey, uint32_t, VertexKeyHash>& welded, const vector<int>& original,
+    const vector<vvr::LineSeg3D>& loops, int begin, int end, vector<uint32_t>& ids, vector<int>& polygon)
+{
+    ids.clear();
+    polygon.clear();
+
+    for (int s = begin; s < end; s++)
+    {
+        auto it = welded.find(MakeVertexKey(vec(loops[s].x1, loops[s].y1, loops[s].z1)));
+        if (it == welded.end()) return 0;
+
+        ids.push_back(it->second);
+    }
+
+    if (ids.size() < 3) return 0;
+
+    // To trigwno ths prwths akmhs: an exei th fora a->b, to gemisma prepei na exei b->a
+    int e = FindEdge(adj, ids[0], ids[1]);
+    if (e < 0) return 0;
+
+    int reverse = 0;
+
+    for (int j = adj.edge_offsets[e]; j < adj.edge_offsets[e + 1]; j++)
+    {
+        int f = adj.edge_faces[j];
+        if (adj.removed[f]) continue;
+
+        const uint32_t* v = &adj.face_vertices[3 * f];
+
+        for (int k = 0; k < 3; k++)
+            if (v[k] == ids[0] && v[(k + 1) % 3] == ids[1]) reverse = 1;
+
+        break;
+    }
+
+    if (reverse) std::reverse(ids.begin(), ids.end());
+
+    for (int i = 0; i < ids.size(); i++)
+        polygon.push_back(original[ids[i]]);
+
+    return 1;
+}
+
+// Trigwnopoihsh enos brogxou: oi mikroi me dynamic programming, oi megaloi me ear clipping
+// Epistrefei to plh8os twn xwrismatwn tou ear clipping h -1 an den trigwnopoih8hke
+static int TriangulateLoop(const vector<vec>& points, vector<int>& local, const BlockedDiagonal& blocked)
+{
+    local.clear();
+
+    if (points.size() <= HOLE_DP_MAX) return MinWeightTriangulation(points, local, blocked) ? 0 : -1;
+    return EarClipping(points, local, blocked);
+}
+
+// Oi diagwnies ths trigwnopoihshs (oi akmes pou den einai akmes tou brogxou) ws
+// kleidia akmwn tou montelou
+static void LoopDiagonals(const vector<int>& local, const vector<uint32_t>& loop_ids, vector<uint64_t>& diagonals)
+{
+    int n = loop_ids.size();
+    diagonals.clear();
+
+    for (int t = 0; t + 2 < local.size(); t += 3)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            int a = min(local[t + k], local[t + (k + 1) % 3]);
+            int b = max(local[t + k], local[t + (k + 1) % 3]);
+            if (b - a == 1 || (a == 0 && b == n - 1)) continue;
+
+            diagonals.push_back(EdgeKey(loop_ids[a], loop_ids[b]));
+        }
+    }
+
+    // Ka8e diagwnios anhkei se 2 trigwna
+    sort(diagonals.begin(), diagonals.end());
+    diagonals.erase(unique(diagonals.begin(), diagonals.end()), diagonals.end());
+}
+
+// Kommati ths ophs pou trigwnopoieitai xwrista: ena apo ta apla kommatia tou
+// brogxou (ka8e koryfh mia fora), me tis koryfes tou ws ids kai ws koryfes tou montelou
+struct HolePart
+{
+    int hole;
+    int state;
+    std::vector<uint32_t> ids;
+    std::vector<int> polygon;
+    std::vector<int> local;
+    std::vector<uint64_t> diagonals;
+};
+
+// Xwrismos tou brogxou sta shmeia pou pernaei 3ana apo thn idia koryfh, wste
+// ka8e kommati na einai aplo kai oi diagwnies tou na einai diaforetikes akmes
+static void SplitLoop(int hole, const vector<uint32_t>& ids, const vector<int>& polygon, vector<HolePart>& parts)
+{
+    unordered_map<uint32_t, int> on_stack;
+    vector<int> stack;
+
+    auto emit = [&](int from) {
+        if (stack.size() - from >= 3)
+        {
+            HolePart part;
+            part.hole = hole;
+            part.state = -1;
+
+            for (int s = from; s < stack.size(); s++)
+            {
+                part.ids.push_back(ids[stack[s]]);
+                part.polygon.push_back(polygon[stack[s]]);
+            }
+
+            parts.push_back(part);
+        }
+    };
+
+    for (int i = 0; i < ids.size(); i++)
+    {
+        auto it = on_stack.find(ids[i]);
+
+        if (it == on_stack.end())
+        {
+            on_stack[ids[i]] = stack.size();
+            stack.push_back(i);
+            continue;
+        }
+
+        // To kommati apo thn prohgoumenh emfanish ws edw kleinei
+        int from = it->second;
+        emit(from);
+
+        for (int s = from + 1; s < stack.size(); s++) on_stack.erase(ids[stack[s]]);
+        stack.resize(from + 1);
+    }
+
+    emit(0);
+}
+
+// Trigwnopoihsh olwn twn opwn (parallhla, ena kommati ophs ana task)
+// Mia diagwnios den mpainei pote an yparxei hdh ws akmh tou montelou h enwnei thn
+// idia koryfh. Meta to parallhlo perasma ta kommatia elegxontai me th seira: an mia
+// diagwnios yparxei hdh sto gemisma allou kommatiou, to kommati 3anatrigwnopoieitai
+// me blocked kai tis akmes twn prohgoumenwn gemismatwn. Ta kommatia pou den ginetai
+// na trigwnopoih8oun etsi menoun anoikta, wste to montelo na menei manifold
+// Ta nea trigwna mpainoun sto patch kai to patch_ends[l] einai to telos ths ophs l
+// Epistrefei to plh8os twn newn trigwnwn
+int TriangulateHoles(std::vector<vvr::Triangle>& tris, const EdgeAdjacency& adj, std::vector<vvr::LineSeg3D>& loops,
+    std::vector<int>& loop_ends, std::vector<vvr::Triangle>& patch, std::vector<int>& patch_ends)
+{
+    StatTimer timer("TriangulateHoles");
+
+    patch.clear();
+    patch_ends.clear();
+
+    if (tris.empty() || loop_ends.empty()) return 0;
+
+    vector<vec>* vertices = tris[0].vecList;
+
+    // 8esh -> enwmeno id -> prwth koryfh tou montelou me ayto to id
+    unordered_map<VertexKey, uint32_t, VertexKeyHash> welded;
+    welded.reserve(adj.vertices.size());
+    for (int w = 0; w < adj.vertices.size(); w++)
+        welded.insert(make_pair(MakeVertexKey(adj.vertices[w]), (uint32_t)w));
+
+    vector<int> original(adj.vertices.size(), -1);
+    for (int i = adj.vertex_ids.size() - 1; i >= 0; i--)
+        original[adj.vertex_ids[i]] = i;
+
+    int holes = loop_ends.size();
+    vector<HolePart> parts;
+    vector<uint32_t> ids;
+    vector<int> polygon;
+
+    for (int l = 0; l < holes; l++)
+    {
+        int begin = (l == 0) ? 0 : loop_ends[l - 1] + 1;
+        int end = loop_ends[l] + 1;
+
+        if (LoopVertices(adj, welded, original, loops, begin, end, ids, polygon)) SplitLoop(l, ids, polygon, parts);
+    }
+
+    ThreadPool& pool = ThreadPool::Global();
+    vector<vector<vec> > points(pool.Size());
+
+    // Diagwnies pou enwnoun thn idia koryfh h yparxoun hdh ws akmes tou montelou
+    auto model_blocked = [&](const vector<uint32_t>& part_ids, int i, int j) {
+        return part_ids[i] == part_ids[j] || EdgeCount(adj, part_ids[i], part_ids[j]) > 0;
+    };
+
+    // To state einai to plh8os twn xwrismatwn h -1 an to kommati den gemise
+    pool.ParallelFor(parts.size(), 1, [&](int thread, int first, int last) {
+        for (int p = first; p < last; p++)
+        {
+            HolePart& part = parts[p];
+
+            points[thread].clear();
+            for (int i = 0; i < part.polygon.size(); i++) points[thread].push_back((*vertices)[part.polygon[i]]);
+
+            BlockedDiagonal blocked = [&](int i, int j) { return model_blocked(part.ids, i, j); };
+
+            part.state = TriangulateLoop(points[thread], part.local, blocked);
+            if (part.state >= 0) LoopDiagonals(part.local, part.ids, part.diagonals);
+        }
+    });
+
+    // Oi diagwnies twn gemismatwn pou exoun ginei dekta
+    unordered_set<uint64_t> patch_edges;
+    vector<char> split(holes, 0), unfilled(holes, 0);
+    vector<vec> retry;
+
+    for (int p = 0; p < parts.size(); p++)
+    {
+        HolePart& part = parts[p];
+
+        int conflict = part.state < 0;
+        for (int d = 0; d < part.diagonals.size() && !conflict; d++)
+            conflict = patch_edges.count(part.diagonals[d]) > 0;
+
+        if (conflict)
+        {
+            BlockedDiagonal blocked = [&](int i, int j) {
+                return model_blocked(part.ids, i, j) || patch_edges.count(EdgeKey(part.ids[i], part.ids[j])) > 0;
+            };
+
+            retry.clear();
+            for (int i = 0; i < part.polygon.size(); i++) retry.push_back((*vertices)[part.polygon[i]]);
+
+            part.state = TriangulateLoop(retry, part.local, blocked);
+            if (part.state >= 0) LoopDiagonals(part.local, part.ids, part.diagonals);
+        }
+
+        if (part.state < 0)
+        {
+            part.local.clear();
+            unfilled[part.hole] = 1;
+            continue;
+        }
+
+        if (part.state > 0) split[part.hole] = 1;
+        patch_edges.insert(part.diagonals.begin(), part.diagonals.end());
+    }
+
+    int splits = 0, skipped = 0;
+    for (int l = 0; l < holes; l++)
+    {
+        splits += split[l];
+        skipped += unfilled[l];
+    }
+
+    if (splits > 0) cout << "Holes split (no valid ear): " << splits << endl;
+    if (skipped > 0) cout << "Holes not filled (no manifold triangulation): " << skipped << endl;
+
+    // Ta kommatia einai me th seira twn opwn
+    for (int l = 0, p = 0; l < holes; l++)
+    {
+        for (; p < parts.size() && parts[p].hole == l; p++)
+        {
+            const HolePart& part = parts[p];
+
+            for (int i = 0; i + 2 < part.local.size(); i += 3)
+                patch.push_back(vvr::Triangle(vertices, part.polygon[part.local[i]], part.polygon[part.local[i + 1]], part.polygon[part.local[i + 2]]));
+        }
+
+        patch_ends.push_back(patch.size());
+    }
+
+    return patch.size();
+}
+
+// Gemisma twn opwn: ta nea trigwna prosti8entai sto telos tou tris
+// To patch_ends[l] einai to telos ths ophs l mesa sto tris
+int FillHoles(std::vector<vvr::Triangle>& tris, const EdgeAdjacency& adj, std::vector<vvr::LineSeg3D>& loops,
+    std::vector<int>& loop_ends, std::vector<int>& patch_ends)
+{
+    vector<vvr::Triangle> patch;
+    int added = TriangulateHoles(tris, adj, loops, loop_ends, patch, patch_ends);
+
+    int base = tris.size();
+    tris.insert(tris.end(), patch.begin(), patch.end());
+
+    for (int l = 0; l < patch_ends.size(); l++) patch_ends[l] += base;
+
+    return added;
+}
+
+// Xrwmatismos twn trigwnwn tou gemismatos (sth 8esh tou montelou an dinetai o metasxhmatismos)
+void DrawPatch(std::vector<vvr::Triangle>& patch, const ModelTransform* t)
+{
+    ModelTransform identity;
+    IdentityTransform(identity);
+    if (!t) t = &identity;
+
+    for (int i = 0; i < patch.size(); i++)
+    {
+        const vvr::Triangle& p = patch[i];
+        math::Triangle moved(TransformPoint(*t, p.v1()), TransformPoint(*t, p.v2()), TransformPoint(*t, p.v3()));
+        math2vvr(moved, vvr::Colour::orange).draw();
+    }
+}
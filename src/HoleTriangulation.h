@@ -0,0 +1,35 @@
+#pragma once
+
+#include <VVRScene/canvas.h>
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include "EdgeAdjacency.h"
+#include <functional>
+#include <vector>
+
+// Gemisma twn opwn me trigwnopoihsh twn brogxwn ths SortEdges.
+// Oi mikres opes (ws HOLE_DP_MAX koryfes) trigwnopoiountai me dynamic programming
+// (trigwnopoihsh elaxistou embadou), enw oi megales me ear clipping pou
+// kobei prwta ta egkyra "ayti" me th mikroterh gwnia (priority queue).
+// Otan den yparxei egkyro ayti, h oph xwrizetai se mia diagwnio.
+// Oi brogxoi pou pernane 2 fores apo mia koryfh xwrizontai se apla kommatia.
+// Kamia diagwnios den einai hdh akmh tou montelou h allou gemismatos, opote
+// to gemismeno montelo menei manifold. Ta kommatia pou den ginetai na gemisoun
+// etsi menoun anoikta.
+// Ta nea trigwna xrhsimopoioun tis koryfes tou montelou kai exoun ton idio
+// prosanatolismo me ta trigwna gyrw apo thn oph.
+#define HOLE_DP_MAX 100
+
+struct ModelTransform;
+
+// Diagwnies (i, j) tou polygwnou pou den prepei na mpoun, p.x. giati yparxoun hdh sto montelo
+typedef std::function<int(int, int)> BlockedDiagonal;
+
+// Synarthseis gemismatos
+int MinWeightTriangulation(const std::vector<vec>& points, std::vector<int>& triangles, const BlockedDiagonal& blocked = BlockedDiagonal());
+int EarClipping(const std::vector<vec>& points, std::vector<int>& triangles, const BlockedDiagonal& blocked = BlockedDiagonal());
+int TriangulateHoles(std::vector<vvr::Triangle>& tris, const EdgeAdjacency& adj, std::vector<vvr::LineSeg3D>& loops,
+    std::vector<int>& loop_ends, std::vector<vvr::Triangle>& patch, std::vector<int>& patch_ends);
+int FillHoles(std::vector<vvr::Triangle>& tris, const EdgeAdjacency& adj, std::vector<vvr::LineSeg3D>& loops,
+    std::vector<int>& loop_ends, std::vector<int>& patch_ends);
+void DrawPatch(std::vector<vvr::Triangle>& patch, const ModelTransform* t = 0);
@@ -0,0 +1,375 @@
+#include "JobService.h"
+#include "ObjLoader.h"
+#include <algorithm>
+#include <exception>
+#include <sstream>
+
+using namespace std;
+
+MeshCache::MeshCache(int max_meshes, int use_cache)
+    : max_meshes(std::max(1, max_meshes)), use_cache(use_cache), hits(0), misses(0)
+{
+}
+
+// Epistrefei to montelo tou arxeiou, fortwmeno. An to fortwnei hdh allh
+// douleia perimenei na teleiwsei. An h fortwsh apotyxei to montelo menei
+// afortwto (h epomenh Get 3anadokimazei) kai h exception pernaei ston caller
+std::shared_ptr<CachedMesh> MeshCache::Get(const std::string& file)
+{
+    std::shared_ptr<CachedMesh> entry;
+
+    {
+        lock_guard<std::mutex> guard(lock);
+
+        for (auto it = meshes.begin(); it != meshes.end(); ++it)
+        {
+            if ((*it)->file != file) continue;
+
+            // Sthn arxh ths listas ta pio prosfata
+            entry = *it;
+            meshes.erase(it);
+            break;
+        }
+
+        if (entry) hits++;
+        else
+        {
+            misses++;
+            entry = std::make_shared<CachedMesh>();
+            entry->file = file;
+        }
+
+        meshes.push_front(entry);
+        Evict();
+    }
+
+    lock_guard<std::mutex> guard(entry->lock);
+
+    if (!entry->loaded)
+    {
+        StatTimer timer("LoadCachedMesh");
+
+        LoadObj(file, entry->mesh, &entry->local_aabb, use_cache);
+        UpdateCollisionCache(entry->mesh.getTriangles(), entry->version, entry->cache);
+        entry->loaded = 1;
+    }
+
+    return entry;
+}
+
+// Afairesh twn palaioterwn montelwn pou den xrhsimopoiountai pera apo to orio
+void MeshCache::Evict()
+{
+    auto it = meshes.end();
+
+    while (meshes.size() > max_meshes && it != meshes.begin())
+    {
+        --it;
+        if (it->use_count() > 1) continue;
+
+        it = meshes.erase(it);
+    }
+}
+
+// To caller thread den douleyei: oi workers einai ta mona threads pou ektelei douleies.
+// Me perissoterous apo enan workers to FindCollisions trexei seiriaka mesa se ka8e douleia,
+// afou h parallhlia erxetai apo tis douleies
+JobService::JobService(int workers_count, int max_queue, MeshCache& cache, const std::function<void(const MeshJobResult&)>& on_result)
+    : cache(cache), on_result(on_result), max_queue(std::max(1, max_queue)), stop(false)
+{
+    if (workers_count <= 0) workers_count = std::thread::hardware_concurrency();
+    if (workers_count <= 0) workers_count = 1;
+
+    parallel = (workers_count == 1);
+
+    metrics.submitted = metrics.completed = metrics.failed = metrics.running = 0;
+    metrics.queue_depth = metrics.max_queue_depth = 0;
+    metrics.elapsed_ms = 0;
+    metrics.latency_count = 0;
+    metrics.latency_sum = metrics.latency_max = 0;
+    start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < workers_count; i++)
+        workers.push_back(std::thread(&JobService::Worker, this));
+}
+
+JobService::~JobService()
+{
+    {
+        lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    not_empty.notify_all();
+
+    for (int i = 0; i < workers.size(); i++) workers[i].join();
+}
+
+double JobService::NowMs() const
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Prosthikh douleias sthn oura (perimenei oso h oura einai gemath)
+void JobService::Submit(const MeshJob& job)
+{
+    unique_lock<std::mutex> guard(lock);
+    not_full.wait(guard, [&] { return queue.size() < max_queue; });
+
+    QueuedJob queued = { job, NowMs() };
+    queue.push_back(queued);
+
+    metrics.submitted++;
+    metrics.queue_depth = queue.size();
+    metrics.max_queue_depth = std::max(metrics.max_queue_depth, metrics.queue_depth);
+
+    not_empty.notify_one();
+}
+
+// Anamonh mexri na teleiwsoun oles oi douleies pou exoun dw8ei
+void JobService::Finish()
+{
+    unique_lock<std::mutex> guard(lock);
+    idle.wait(guard, [&] { return queue.empty() && metrics.running == 0; });
+}
+
+// O mesos oros kai to max metrane oles tis douleies, ta percentiles tis teleytaies
+// SERVICE_LATENCY_WINDOW (kyklikos buffer), wste h mnhmh na menei sta8erh
+static void AddLatency(ServiceMetrics& metrics, double ms)
+{
+    if (metrics.latencies.size() < SERVICE_LATENCY_WINDOW) metrics.latencies.push_back(ms);
+    else metrics.latencies[metrics.latency_count % SERVICE_LATENCY_WINDOW] = ms;
+
+    metrics.latency_count++;
+    metrics.latency_sum += ms;
+    metrics.latency_max = std::max(metrics.latency_max, ms);
+}
+
+ServiceMetrics JobService::Metrics()
+{
+    lock_guard<std::mutex> guard(lock);
+
+    ServiceMetrics snapshot = metrics;
+    snapshot.elapsed_ms = NowMs();
+    return snapshot;
+}
+
+void JobService::Worker()
+{
+    while (true)
+    {
+        QueuedJob queued;
+
+        {
+            unique_lock<std::mutex> guard(lock);
+            not_empty.wait(guard, [&] { return stop || !queue.empty(); });
+            if (queue.empty()) return;
+
+            queued = queue.front();
+            queue.pop_front();
+            metrics.queue_depth = queue.size();
+            metrics.running++;
+        }
+        not_full.notify_one();
+
+        MeshJobResult result;
+        double begin = NowMs();
+        RunMeshJob(queued.job, cache, parallel, result);
+        result.wait_ms = begin - queued.queued_ms;
+        result.run_ms = NowMs() - begin;
+
+        {
+            lock_guard<std::mutex> guard(lock);
+            metrics.running--;
+            metrics.completed++;
+            if (!result.ok) metrics.failed++;
+            AddLatency(metrics, result.wait_ms + result.run_ms);
+
+            result.queue_depth = metrics.queue_depth;
+            result.jobs_per_s = 1000.0 * metrics.completed / std::max(NowMs(), 1e-3);
+        }
+
+        // Ta apotelesmata bgainoun ena ena, me th seira pou teleiwnoun
+        {
+            lock_guard<std::mutex> guard(result_lock);
+            if (on_result) on_result(result);
+        }
+
+        {
+            lock_guard<std::mutex> guard(lock);
+            if (queue.empty() && metrics.running == 0) idle.notify_all();
+        }
+    }
+}
+
+// Anagnwsh mias grammhs tou manifest: "<obj1> <obj2> <out> [keep [x1 y1 z1 x2 y2 z2]]"
+// (to keep opws sto keepObj kai oi metatopiseis twn 2 montelwn).
+// Oi sxetikes diadromes einai ws pros to dir. Epistrefei 0 gia kenes grammes kai sxolia (#)
+int ParseJob(const std::string& line, const std::string& dir, MeshJob& job)
+{
+    istringstream ss(line);
+    string obj1;
+    if (!(ss >> obj1) || obj1[0] == '#') return 0;
+
+    string obj2, out;
+    if (!(ss >> obj2 >> out)) throw string("Invalid job: ") + line;
+
+    job.keep = 1;
+    IdentityTransform(job.t1);
+    IdentityTransform(job.t2);
+
+    // To keep kai oi metatopiseis einai proairetika, alla oi metatopiseis dinontai
+    // ola h kanena: mia grammh me merikes apo tis 6 times aporriptetai
+    if (!(ss >> ws).eof())
+    {
+        if (!(ss >> job.keep) || (job.keep != 1 && job.keep != 2)) throw string("Invalid keep in job: ") + line;
+
+        vec& s1 = job.t1.translation;
+        vec& s2 = job.t2.translation;
+
+        if (!(ss >> ws).eof() && !(ss >> s1.x >> s1.y >> s1.z >> s2.x >> s2.y >> s2.z))
+            throw string("Invalid translation in job (needs 6 values): ") + line;
+
+        string extra;
+        if (ss >> extra) throw string("Invalid job: ") + line;
+    }
+
+    string* names[3] = { &obj1, &obj2, &out };
+    for (int n = 0; n < 3; n++)
+    {
+        string& name = *names[n];
+        if (name[0] != '/' && !(name.size() > 1 && name[1] == ':')) name = dir + name;
+    }
+
+    job.obj1 = obj1;
+    job.obj2 = obj2;
+    job.out = out;
+
+    return 1;
+}
+
+// Ektelesh mias douleias: collision -> cleaning -> holes, opws h RunPipeline,
+// alla me ta montela ths cache sto topiko tous systhma. Apo thn cache mono
+// diabazoun ola, ektos apo to antigrafo twn trigwnwn tou montelou pou kratame.
+// Ta arxeia e3odou (<out>_cleaned.obj, _holes.obj, _loops.obj) einai sto systhma tou kosmou
+void RunMeshJob(const MeshJob& job, MeshCache& cache, int parallel, MeshJobResult& result)
+{
+    StatTimer timer("RunMeshJob");
+
+    result.id = job.id;
+    result.out = job.out;
+    result.ok = 0;
+    result.collided = result.triangles = result.hole_edges = result.hole_loops = 0;
+    result.queue_depth = 0;
+    result.jobs_per_s = 0;
+
+    try {
+        std::shared_ptr<CachedMesh> mesh_1 = cache.Get(job.obj1);
+        std::shared_ptr<CachedMesh> mesh_2 = cache.Get(job.obj2);
+
+        vector<vvr::Triangle>& tri1 = mesh_1->mesh.getTriangles();
+        vector<vvr::Triangle>& tri2 = mesh_2->mesh.getTriangles();
+
+        vvr::Box3D aabb_1, aabb_2;
+        TransformAABB(mesh_1->local_aabb, job.t1, aabb_1);
+        TransformAABB(mesh_2->local_aabb, job.t2, aabb_2);
+
+        vector<pair<int, int> > hits;
+
+        if (TestAABBs(aabb_1, aabb_2))
+        {
+            // Ta 2 montela menoun sto topiko tous systhma me tis caches tous
+            FindCollisionsLocal(tri1, job.t1, mesh_1->cache, tri2, job.t2, mesh_2->cache, hits, parallel);
+        }
+
+        vector<char> removed1(tri1.size(), 0);
+        vector<char> removed2(tri2.size(), 0);
+        MarkCollisions(hits, removed1, removed2);
+
+        CachedMesh& kept_mesh = (job.keep == 2) ? *mesh_2 : *mesh_1;
+        const ModelTransform& transform = (job.keep == 2) ? job.t2 : job.t1;
+
+        // Antigrafo twn trigwnwn, giati to cleaning afairei trigwna
+        vector<vvr::Triangle> kept = kept_mesh.mesh.getTriangles();
+
+        EdgeAdjacency adj;
+        BuildEdgeAdjacency(kept, adj, (job.keep == 2) ? &removed2 : &removed1);
+        CleanTeeth(adj);
+
+        vector<vvr::LineSeg3D> edges, loops;
+        vector<int> loop_ends;
+        CollectHoleEdges(kept, adj, edges);
+        SortEdges(edges, loops, loop_ends);
+        CompactTriangles(kept, adj.removed);
+
+        for (int e = 0; e < edges.size(); e++) edges[e] = TransformSegment(transform, edges[e]);
+        for (int l = 0; l < loops.size(); l++) loops[l] = TransformSegment(transform, loops[l]);
+
+        vector<vec> baked;
+        BakeTransform(kept_mesh.mesh.getVertices(), transform, baked);
+        WriteObj(job.out + "_cleaned.obj", baked, kept);
+        WriteEdges(job.out + "_holes.obj", edges);
+        WriteLoops(job.out + "_loops.obj", loops, loop_ends);
+
+        result.ok = 1;
+        result.collided = !hits.empty();
+        result.triangles = kept.size();
+        result.hole_edges = edges.size();
+        result.hole_loops = loop_ends.size();
+    }
+    catch (std::string exc) {
+        result.error = exc;
+    }
+    catch (std::exception& exc) {
+        result.error = exc.what();
+    }
+    catch (...) {
+        result.error = "Unknown exception";
+    }
+}
+
+// Mia grammh ana douleia pou teleiwse, me ton ry8mo mexri ekeinh th stigmh
+void PrintJobResult(std::ostream& out, const MeshJobResult& result)
+{
+    out << "job " << result.id << " " << (result.ok ? "ok" : "failed") << " " << result.out;
+
+    if (result.ok)
+    {
+        out << " collision=" << (result.collided ? "yes" : "no")
+            << " triangles=" << result.triangles
+            << " hole_edges=" << result.hole_edges
+            << " hole_loops=" << result.hole_loops;
+    }
+    else out << " error=\"" << result.error << "\"";
+
+    out << " wait_ms=" << result.wait_ms
+        << " run_ms=" << result.run_ms
+        << " queue=" << result.queue_depth
+        << " jobs_per_s=" << result.jobs_per_s
+        << std::endl;
+}
+
+// Synolikes metrhseis: douleies, ry8mos, latency (oura + ektelesh) kai cache montelwn
+void PrintServiceMetrics(std::ostream& out, const ServiceMetrics& metrics, const MeshCache& cache)
+{
+    // Ta percentiles einai panw stis teleytaies SERVICE_LATENCY_WINDOW douleies
+    vector<double> latencies = metrics.latencies;
+    sort(latencies.begin(), latencies.end());
+
+    double mean = (metrics.latency_count > 0) ? metrics.latency_sum / metrics.latency_count : 0;
+
+    auto percentile = [&](double p) {
+        if (latencies.empty()) return 0.0;
+        return latencies[std::min(latencies.size() - 1, (size_t)(p * latencies.size()))];
+    };
+
+    double seconds = metrics.elapsed_ms / 1000.0;
+
+    out << "Jobs:          " << metrics.completed << " (" << metrics.failed << " failed)"
+        << std::endl << "Elapsed:       " << metrics.elapsed_ms << " ms"
+        << std::endl << "Throughput:    " << ((seconds > 0) ? metrics.completed / seconds : 0) << " jobs/s"
+        << std::endl << "Latency:       mean " << mean << " ms, p50 " << percentile(0.5) << " ms, p95 "
+        << percentile(0.95) << " ms, max " << metrics.latency_max << " ms"
+        << std::endl << "Queue depth:   max " << metrics.max_queue_depth
+        << std::endl << "Mesh cache:    " << cache.Hits() << " hits, " << cache.Misses() << " misses"
+        << std::endl;
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <VVRScene/canvas.h>
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include "HoleFilling.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Ypiresia (service) pou ektelei polles douleies zeugwn montelwn.
+// Oi douleies diabazontai apo ena manifest (mia ana grammh) kai mpainoun se
+// oura me orio, thn opoia adeiazoun liga worker threads. Ta montela fortwnontai
+// mia fora kai moirazontai metaksy twn douleiwn (MeshCache) mazi me ta dedomena
+// tou narrow phase sto topiko tous systhma, opote oi douleies pou exoun koina
+// arxeia den 3anadiabazoun to obj oute 3anaftiaxnoun to BVH.
+// To apotelesma ka8e douleias bgainei molis teleiwsei.
+
+// Mia douleia: ta 2 montela me tous metasxhmatismous tous, poio kratame
+// (opws to keepObj) kai to prefix twn arxeiwn e3odou
+struct MeshJob
+{
+    int id;
+    std::string obj1, obj2;
+    std::string out;
+    int keep;
+    ModelTransform t1, t2;
+};
+
+// Apotelesma mias douleias. To wait_ms einai o xronos sthn oura kai
+// to run_ms o xronos ektelesh. To queue_depth kai to jobs_per_s einai
+// h oura kai o ry8mos ths ypiresias th stigmh pou teleiwse
+struct MeshJobResult
+{
+    int id;
+    std::string out;
+    int ok;
+    std::string error;
+    int collided;
+    int triangles;
+    int hole_edges;
+    int hole_loops;
+    double wait_ms;
+    double run_ms;
+    int queue_depth;
+    double jobs_per_s;
+};
+
+// Fortwmeno montelo ths cache. Meta th fortwsh oi koryfes, ta trigwna kai h
+// CollisionCache (sto topiko systhma) mono diabazontai, opote moirazontai
+// xwris kleidwma apo oles tis douleies. To montelo den allazei meta th
+// fortwsh, opote exei mia ekdosh (version) gia thn CollisionCache
+struct CachedMesh
+{
+    std::string file;
+    vvr::Mesh mesh;
+    vvr::Box3D local_aabb;
+    CollisionCache cache;
+    std::mutex lock;
+    int version;
+    int loaded;
+
+    CachedMesh() : version(1), loaded(0) {}
+};
+
+// LRU cache apo montela me orio sto plh8os tous
+// Ta montela pou xrhsimopoiei akoma kapoia douleia den afairountai
+class MeshCache
+{
+public:
+    MeshCache(int max_meshes, int use_cache);
+
+    std::shared_ptr<CachedMesh> Get(const std::string& file);
+    int Hits() const { return hits; }
+    int Misses() const { return misses; }
+
+private:
+    void Evict();
+
+    int max_meshes;
+    int use_cache;
+    std::atomic<int> hits, misses;
+    std::mutex lock;
+    std::list<std::shared_ptr<CachedMesh> > meshes;
+};
+
+// Douleies pou kratane ta percentiles tou latency
+#define SERVICE_LATENCY_WINDOW 4096
+
+// Metrhseis ths ypiresias: douleies, oura, xronoi kai ry8mos
+struct ServiceMetrics
+{
+    int submitted;
+    int completed;
+    int failed;
+    int running;
+    int queue_depth;
+    int max_queue_depth;
+    double elapsed_ms;
+
+    // Oi teleytaies SERVICE_LATENCY_WINDOW latencies (kyklikos buffer) kai ta synola olwn
+    std::vector<double> latencies;
+    long long latency_count;
+    double latency_sum;
+    double latency_max;
+};
+
+// Oura douleiwn me orio kai workers pou ektelei h RunMeshJob.
+// H Submit perimenei oso h oura einai gemath. To on_result kaleitai apo ton
+// worker molis teleiwsei mia douleia, ena ka8e fora
+class JobService
+{
+public:
+    JobService(int workers, int max_queue, MeshCache& cache, const std::function<void(const MeshJobResult&)>& on_result);
+    ~JobService();
+
+    void Submit(const MeshJob& job);
+    void Finish();
+    ServiceMetrics Metrics();
+
+private:
+    struct QueuedJob
+    {
+        MeshJob job;
+        double queued_ms;
+    };
+
+    void Worker();
+    double NowMs() const;
+
+    MeshCache& cache;
+    std::function<void(const MeshJobResult&)> on_result;
+    int parallel;
+    int max_queue;
+
+    std::vector<std::thread> workers;
+    std::deque<QueuedJob> queue;
+    std::mutex lock;
+    std::mutex result_lock;
+    std::condition_variable not_empty, not_full, idle;
+    bool stop;
+
+    ServiceMetrics metrics;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Synarthseis ypiresias
+int ParseJob(const std::string& line, const std::string& dir, MeshJob& job);
+void RunMeshJob(const MeshJob& job, MeshCache& cache, int parallel, MeshJobResult& result);
+void PrintJobResult(std::ostream& out, const MeshJobResult& result);
+void PrintServiceMetrics(std::ostream& out, const ServiceMetrics& metrics, const MeshCache& cache);
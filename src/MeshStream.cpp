@@ -0,0 +1,662 @@
+#include "MeshStream.h"
+#include "HoleFilling.h"
+#include "MeshWeld.h"
+#include "ObjLoader.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+using namespace std;
+
+// Mege8os twn kommatiwn tou obj pou diabazontai ka8e fora
+#define STREAM_SLICE_BYTES (4 << 20)
+// Trigwna pou mazeyontai ana chunk prin graftoun sto disko
+#define STREAM_WRITE_BATCH 256
+
+static string ChunkFile(const StreamMesh& mesh, int chunk, const char* ext)
+{
+    char name[32];
+    sprintf(name, "_chunk%d", chunk);
+    return mesh.prefix + name + ext;
+}
+
+// Telos tou epomenou kommatiou tou obj (se allagh grammhs)
+static const char* NextSlice(const char* p, const char* end)
+{
+    if (end - p <= STREAM_SLICE_BYTES) return end;
+
+    const char* nl = (const char*)memchr(p + STREAM_SLICE_BYTES, '\n', end - p - STREAM_SLICE_BYTES);
+    return nl ? nl + 1 : end;
+}
+
+static void GrowAABB(vvr::Box3D& aabb, const vec& v, int first)
+{
+    if (first)
+    {
+        aabb.x1 = aabb.x2 = v.x;
+        aabb.y1 = aabb.y2 = v.y;
+        aabb.z1 = aabb.z2 = v.z;
+        return;
+    }
+
+    if (v.x > aabb.x1) aabb.x1 = v.x;
+    if (v.y > aabb.y1) aabb.y1 = v.y;
+    if (v.z > aabb.z1) aabb.z1 = v.z;
+
+    if (v.x < aabb.x2) aabb.x2 = v.x;
+    if (v.y < aabb.y2) aabb.y2 = v.y;
+    if (v.z < aabb.z2) aabb.z2 = v.z;
+}
+
+static void AppendChunk(const StreamMesh& mesh, int chunk, vector<StreamTriangle>& batch)
+{
+    if (batch.empty()) return;
+
+    string file = ChunkFile(mesh, chunk, ".bin");
+    FILE* out = fopen(file.c_str(), "ab");
+    if (!out) throw string("Cannot write ") + file;
+
+    size_t written = fwrite(&batch[0], sizeof(StreamTriangle), batch.size(), out);
+    fclose(out);
+    if (written != batch.size()) throw string("Cannot write ") + file;
+
+    batch.clear();
+}
+
+// // // // // //
+// Chunks
+// // // // // //
+
+// Xwrismos tou obj se chunks sto disko, me dyo perasmata:
+// 1) oi koryfes (metatopismenes kata shift) grafontai sto <prefix>_vertices.bin
+// 2) ka8e trigwno grafetai sto chunk tou keliou pou periexei to kentro tou
+// To plegma dialegetai wste ena chunk na xwraei arketes fores sto max_bytes
+void BuildStreamMesh(const std::string& file, const vec& shift, const std::string& prefix, size_t max_bytes, StreamMesh& mesh)
+{
+    StatTimer timer("BuildStreamMesh");
+
+    MappedFile map;
+    MapFile(file, map);
+
+    const char* data = map.data;
+    const char* end = map.data + map.size;
+    ObjChunk part;
+
+    mesh.prefix = prefix;
+    mesh.vertex_count = 0;
+    mesh.triangle_count = 0;
+
+    string vertex_file = prefix + "_vertices.bin";
+    FILE* out = fopen(vertex_file.c_str(), "wb");
+    if (!out) throw string("Cannot write ") + vertex_file;
+
+    for (const char* p = data; p < end; )
+    {
+        const char* slice = NextSlice(p, end);
+
+        part.vertices.clear();
+        part.indices.clear();
+        part.relative.clear();
+        ParseObjRange(p, slice, part);
+
+        for (int i = 0; i < part.vertices.size(); i++)
+        {
+            part.vertices[i] += shift;
+            GrowAABB(mesh.aabb, part.vertices[i], mesh.vertex_count + i == 0);
+        }
+
+        if (!part.vertices.empty()) fwrite(&part.vertices[0], sizeof(vec), part.vertices.size(), out);
+
+        mesh.vertex_count += part.vertices.size();
+        mesh.triangle_count += part.indices.size() / 3;
+        p = slice;
+    }
+
+    fclose(out);
+
+    if (mesh.vertex_count == 0)
+    {
+        UnmapFile(map);
+        throw string("No vertices in ") + file;
+    }
+
+    // Megethos plegmatos
+    double target = max(1.0, (double)max_bytes / (4.0 * STREAM_TRIANGLE_BYTES));
+    mesh.grid = (int)ceil(cbrt(mesh.triangle_count / target));
+    mesh.grid = max(1, min(STREAM_MAX_GRID, mesh.grid));
+
+    int chunks = mesh.grid * mesh.grid * mesh.grid;
+    mesh.chunk_aabbs.assign(chunks, mesh.aabb);
+    mesh.chunk_counts.assign(chunks, 0);
+
+    for (int c = 0; c < chunks; c++)
+    {
+        remove(ChunkFile(mesh, c, ".bin").c_str());
+        remove(ChunkFile(mesh, c, ".dead").c_str());
+    }
+
+    MappedFile vertex_map;
+    MapFile(vertex_file, vertex_map);
+    const vec* vertices = (const vec*)vertex_map.data;
+
+    vector<vector<StreamTriangle> > batches(chunks);
+    vec lo(mesh.aabb.x2, mesh.aabb.y2, mesh.aabb.z2);
+    vec extent(mesh.aabb.x1 - mesh.aabb.x2, mesh.aabb.y1 - mesh.aabb.y2, mesh.aabb.z1 - mesh.aabb.z2);
+    uint64_t base = 0;
+
+    for (const char* p = data; p < end; )
+    {
+        const char* slice = NextSlice(p, end);
+
+        part.vertices.clear();
+        part.indices.clear();
+        part.relative.clear();
+        ParseObjRange(p, slice, part);
+
+        for (int r = 0; r < part.relative.size(); r++)
+            part.indices[part.relative[r]] += base;
+
+        for (int t = 0; t + 2 < part.indices.size(); t += 3)
+        {
+            StreamTriangle tri;
+            vec centroid(0, 0, 0);
+
+            for (int k = 0; k < 3; k++)
+            {
+                int index = part.indices[t + k];
+                if (index < 0 || index >= mesh.vertex_count) throw string("Invalid face index in ") + file;
+
+                const vec& v = vertices[index];
+                tri.v[k] = index;
+                tri.p[3 * k] = v.x;
+                tri.p[3 * k + 1] = v.y;
+                tri.p[3 * k + 2] = v.z;
+                centroid += v * (1.0f / 3);
+            }
+
+            // Keli tou plegmatos pou periexei to kentro
+            int cell[3];
+            float c[3] = { centroid.x - lo.x, centroid.y - lo.y, centroid.z - lo.z };
+            float e[3] = { extent.x, extent.y, extent.z };
+
+            for (int a = 0; a < 3; a++)
+            {
+                cell[a] = e[a] > 0 ? (int)(c[a] / e[a] * mesh.grid) : 0;
+                cell[a] = max(0, min(mesh.grid - 1, cell[a]));
+            }
+
+            int chunk = (cell[0] * mesh.grid + cell[1]) * mesh.grid + cell[2];
+
+            for (int k = 0; k < 3; k++)
+                GrowAABB(mesh.chunk_aabbs[chunk], vertices[tri.v[k]], mesh.chunk_counts[chunk] == 0 && k == 0);
+
+            mesh.chunk_counts[chunk]++;
+            batches[chunk].push_back(tri);
+
+            if (batches[chunk].size() >= STREAM_WRITE_BATCH) AppendChunk(mesh, chunk, batches[chunk]);
+        }
+
+        base += part.vertices.size();
+        p = slice;
+    }
+
+    for (int c = 0; c < chunks; c++) AppendChunk(mesh, c, batches[c]);
+
+    UnmapFile(vertex_map);
+    UnmapFile(map);
+}
+
+// Fortwsh enos chunk kai twn trigwnwn tou pou exoun afaire8ei
+void LoadStreamChunk(StreamMesh& mesh, int chunk, StreamChunk& data)
+{
+    data.mesh = &mesh;
+    data.chunk = chunk;
+    data.dirty = 0;
+    data.vertices.clear();
+    data.vertex_ids.clear();
+    data.tris.clear();
+
+    int count = mesh.chunk_counts[chunk];
+    vector<StreamTriangle> records(count);
+
+    if (count > 0)
+    {
+        string file = ChunkFile(mesh, chunk, ".bin");
+        FILE* in = fopen(file.c_str(), "rb");
+        if (!in) throw string("Cannot open ") + file;
+
+        size_t read = fread(&records[0], sizeof(StreamTriangle), count, in);
+        fclose(in);
+        if (read != count) throw string("Cannot read ") + file;
+    }
+
+    // Topikes koryfes, mia gia ka8e koryfh tou obj
+    unordered_map<uint32_t, int> local;
+    local.reserve(count);
+    data.tris.reserve(count);
+
+    for (int t = 0; t < count; t++)
+    {
+        int v[3];
+
+        for (int k = 0; k < 3; k++)
+        {
+            auto it = local.insert(make_pair(records[t].v[k], (int)data.vertices.size()));
+
+            if (it.second)
+            {
+                const float* p = &records[t].p[3 * k];
+                data.vertices.push_back(vec(p[0], p[1], p[2]));
+                data.vertex_ids.push_back(records[t].v[k]);
+            }
+
+            v[k] = it.first->second;
+        }
+
+        data.tris.push_back(vvr::Triangle(&data.vertices, v[0], v[1], v[2]));
+    }
+
+    data.removed.assign(count, 0);
+
+    FILE* in = fopen(ChunkFile(mesh, chunk, ".dead").c_str(), "rb");
+    if (in)
+    {
+        if (count > 0 && fread(&data.removed[0], 1, count, in) != count) data.removed.assign(count, 0);
+        fclose(in);
+    }
+}
+
+void SaveStreamRemoved(StreamChunk& data)
+{
+    string file = ChunkFile(*data.mesh, data.chunk, ".dead");
+    FILE* out = fopen(file.c_str(), "wb");
+    if (!out) throw string("Cannot write ") + file;
+
+    if (!data.removed.empty()) fwrite(&data.removed[0], 1, data.removed.size(), out);
+    fclose(out);
+
+    data.dirty = 0;
+}
+
+// Diagrafh twn arxeiwn tou montelou apo to disko
+void RemoveStreamMesh(StreamMesh& mesh)
+{
+    for (int c = 0; c < mesh.chunk_counts.size(); c++)
+    {
+        remove(ChunkFile(mesh, c, ".bin").c_str());
+        remove(ChunkFile(mesh, c, ".dead").c_str());
+    }
+
+    remove((mesh.prefix + "_vertices.bin").c_str());
+}
+
+// // // // // //
+// Chunk cache
+// // // // // //
+
+ChunkCache::ChunkCache(size_t max_bytes) : max_bytes(max_bytes), bytes(0)
+{
+}
+
+ChunkCache::~ChunkCache()
+{
+    // Den petame exception apo ton destructor, to Flush prepei na klh8ei prin
+    for (auto it = chunks.begin(); it != chunks.end(); ++it)
+    {
+        try { if ((*it)->dirty) SaveStreamRemoved(**it); }
+        catch (...) {}
+    }
+}
+
+StreamChunk& ChunkCache::Get(StreamMesh& mesh, int chunk)
+{
+    for (auto it = chunks.begin(); it != chunks.end(); ++it)
+    {
+        if ((*it)->mesh == &mesh && (*it)->chunk == chunk)
+        {
+            chunks.splice(chunks.begin(), chunks, it);
+            return *chunks.front();
+        }
+    }
+
+    // To prwto ths listas (h prohgoumenh Get) menei panta
+    size_t need = (size_t)mesh.chunk_counts[chunk] * STREAM_TRIANGLE_BYTES;
+
+    while (chunks.size() > 1 && bytes + need > max_bytes)
+    {
+        Evict(*chunks.back());
+        chunks.pop_back();
+    }
+
+    unique_ptr<StreamChunk> data(new StreamChunk);
+    LoadStreamChunk(mesh, chunk, *data);
+
+    bytes += need;
+    chunks.push_front(std::move(data));
+    return *chunks.front();
+}
+
+void ChunkCache::Evict(StreamChunk& chunk)
+{
+    if (chunk.dirty) SaveStreamRemoved(chunk);
+    bytes -= (size_t)chunk.mesh->chunk_counts[chunk.chunk] * STREAM_TRIANGLE_BYTES;
+}
+
+void ChunkCache::Flush()
+{
+    while (!chunks.empty())
+    {
+        Evict(*chunks.back());
+        chunks.pop_back();
+    }
+}
+
+// // // // // //
+// Pipeline
+// // // // // //
+
+static int CountRemoved(const StreamChunk& chunk)
+{
+    int count = 0;
+    for (int i = 0; i < chunk.removed.size(); i++) count += chunk.removed[i] != 0;
+    return count;
+}
+
+// Elegxos tomhs mono gia ta zeugh chunks me epikalyptomena AABB
+// Epistrefei to plh8os twn zeugwn trigwnwn pou temnontai
+int StreamCollisions(StreamMesh& mesh_1, StreamMesh& mesh_2, ChunkCache& cache)
+{
+    StatTimer timer("StreamCollisions");
+
+    vector<pair<int, int> > hits;
+    int total = 0;
+
+    if (!TestAABBs(mesh_1.aabb, mesh_2.aabb)) return 0;
+
+    for (int a = 0; a < mesh_1.chunk_counts.size(); a++)
+    {
+        if (mesh_1.chunk_counts[a] == 0) continue;
+
+        for (int b = 0; b < mesh_2.chunk_counts.size(); b++)
+        {
+            if (mesh_2.chunk_counts[b] == 0) continue;
+            if (!TestAABBs(mesh_1.chunk_aabbs[a], mesh_2.chunk_aabbs[b])) continue;
+
+            StreamChunk& chunk_1 = cache.Get(mesh_1, a);
+            StreamChunk& chunk_2 = cache.Get(mesh_2, b);
+
+            FindCollisions(chunk_1.tris, chunk_2.tris, hits);
+
+            if (!hits.empty())
+            {
+                int before = CountRemoved(chunk_1) + CountRemoved(chunk_2);
+                MarkCollisions(hits, chunk_1.removed, chunk_2.removed);
+                STAT_ADD(STAT_TRIANGLES_REMOVED, CountRemoved(chunk_1) + CountRemoved(chunk_2) - before);
+
+                chunk_1.dirty = chunk_2.dirty = 1;
+                total += hits.size();
+            }
+        }
+    }
+
+    return total;
+}
+
+// Akmh tou montelou pou moirazetai se 2 chunks (rafh)
+// To count einai to plh8os twn energwn trigwnwn ths kai sta 2 chunks
+struct SeamEdge
+{
+    int count;
+    int chunks[2];
+};
+
+// Kleidi rafhs: oi welded 8eseis twn akrwn ths (me th mikroterh prwth), opote
+// oi rafes tairiazoun opws kai oi akmes tou EdgeAdjacency, akoma k an oi koryfes
+// twn 2 chunks einai diaforetikes koryfes tou obj. Me weld_epsilon > 0 oi akres
+// prepei na pesoun sto idio keli tou plegmatos tou WeldVertices
+struct SeamKey
+{
+    WeldKey a, b;
+    bool operator==(const SeamKey& o) const { return a == o.a && b == o.b; }
+};
+
+struct SeamKeyHash
+{
+    size_t operator()(const SeamKey& k) const
+    {
+        uint64_t h = (uint64_t)k.a.x * 73856093u;
+        h = (h ^ (uint64_t)k.a.y) * 19349663u;
+        h = (h ^ (uint64_t)k.a.z) * 83492791u;
+        h = (h ^ (uint64_t)k.b.x) * 73856093u;
+        h = (h ^ (uint64_t)k.b.y) * 19349663u;
+        h = (h ^ (uint64_t)k.b.z) * 83492791u;
+        return h ^ (h >> 32);
+    }
+};
+
+// Oles oi rafes tou montelou. Kratountai sth mnhmh oso trexei to StreamCleaning
+// kai den metrane sto orio tou ChunkCache
+struct SeamTable
+{
+    std::unordered_map<SeamKey, int, SeamKeyHash> index;
+    std::vector<SeamEdge> edges;
+};
+
+#define NO_SEAM -1
+
+// Adjacency tou chunk kai h rafh (8esh sto seams.edges) gia tis akmes pou
+// exoun ena mono trigwno mesa sto chunk, dhladh einai pi8anes rafes
+// Oi kainouries rafes prostithentai sto seams me count 0
+static void ChunkAdjacency(StreamChunk& chunk, EdgeAdjacency& adj, SeamTable& seams, vector<int>& keys)
+{
+    BuildEdgeAdjacency(chunk.tris, adj, &chunk.removed);
+    keys.assign(adj.face_edges.size(), NO_SEAM);
+
+    for (int i = 0; i < chunk.tris.size(); i++)
+    {
+        WeldKey v[3] = {
+            MakeWeldKey(chunk.vertices[chunk.tris[i].vi1], weld_epsilon),
+            MakeWeldKey(chunk.vertices[chunk.tris[i].vi2], weld_epsilon),
+            MakeWeldKey(chunk.vertices[chunk.tris[i].vi3], weld_epsilon)
+        };
+        int e[3][2] = { { 0, 1 }, { 1, 2 }, { 0, 2 } };
+
+        for (int k = 0; k < 3; k++)
+        {
+            int edge = adj.face_edges[3 * i + k];
+            if (adj.edge_offsets[edge + 1] - adj.edge_offsets[edge] != 1) continue;
+
+            const WeldKey& a = v[e[k][0]];
+            const WeldKey& b = v[e[k][1]];
+            SeamKey key = { b < a ? b : a, b < a ? a : b };
+
+            auto it = seams.index.insert(make_pair(key, (int)seams.edges.size()));
+            if (it.second)
+            {
+                SeamEdge seam = { 0, { chunk.chunk, -1 } };
+                seams.edges.push_back(seam);
+            }
+
+            SeamEdge& seam = seams.edges[it.first->second];
+            if (seam.chunks[0] != chunk.chunk) seam.chunks[1] = chunk.chunk;
+
+            keys[3 * i + k] = it.first->second;
+        }
+    }
+}
+
+// Oi metrhseis twn rafwn antikatastoun tis topikes
+static void ApplySeams(EdgeAdjacency& adj, const vector<int>& keys, const SeamTable& seams)
+{
+    for (int s = 0; s < keys.size(); s++)
+        if (keys[s] != NO_SEAM) adj.edge_count[adj.face_edges[s]] = seams.edges[keys[s]].count;
+}
+
+// Cleaning kai eyresh opwn chunk pros chunk
+// Otan afaireitai trigwno panw se rafh, to geitoniko chunk 3anaelegxetai,
+// opote to apotelesma einai idio me to Cleaning olou tou montelou
+// Epistrefei to plh8os twn trigwnwn pou menoun
+int StreamCleaning(StreamMesh& mesh, ChunkCache& cache, std::vector<vvr::LineSeg3D>& edges)
+{
+    StatTimer timer("StreamCleaning");
+
+    SeamTable seams;
+    EdgeAdjacency adj;
+    vector<int> keys;
+    int chunks = mesh.chunk_counts.size();
+
+    // Rafes kai energa trigwna panw se aytes
+    for (int c = 0; c < chunks; c++)
+    {
+        if (mesh.chunk_counts[c] == 0) continue;
+
+        StreamChunk& chunk = cache.Get(mesh, c);
+        ChunkAdjacency(chunk, adj, seams, keys);
+
+        for (int s = 0; s < keys.size(); s++)
+            if (keys[s] != NO_SEAM && !chunk.removed[s / 3]) seams.edges[keys[s]].count++;
+    }
+
+    // Lista ergasiwn apo chunks
+    vector<int> work;
+    vector<char> queued(chunks, 0);
+
+    for (int c = 0; c < chunks; c++)
+    {
+        if (mesh.chunk_counts[c] == 0) continue;
+
+        work.push_back(c);
+        queued[c] = 1;
+    }
+
+    for (int w = 0; w < work.size(); w++)
+    {
+        int c = work[w];
+        queued[c] = 0;
+
+        StreamChunk& chunk = cache.Get(mesh, c);
+        ChunkAdjacency(chunk, adj, seams, keys);
+        ApplySeams(adj, keys, seams);
+
+        int removed = CleanTeeth(adj);
+        if (removed == 0) continue;
+
+        STAT_ADD(STAT_TRIANGLES_REMOVED, removed);
+
+        for (int i = 0; i < chunk.tris.size(); i++)
+        {
+            if (!adj.removed[i] || chunk.removed[i]) continue;
+
+            for (int k = 0; k < 3; k++)
+            {
+                if (keys[3 * i + k] == NO_SEAM) continue;
+
+                SeamEdge& seam = seams.edges[keys[3 * i + k]];
+                seam.count--;
+
+                int other = (seam.chunks[0] == c) ? seam.chunks[1] : seam.chunks[0];
+                if (other >= 0 && !queued[other])
+                {
+                    work.push_back(other);
+                    queued[other] = 1;
+                }
+            }
+        }
+
+        chunk.removed = adj.removed;
+        chunk.dirty = 1;
+    }
+
+    // Akmes opwn: oi rafes me 2 energa trigwna den einai opes
+    int kept = 0;
+
+    for (int c = 0; c < chunks; c++)
+    {
+        if (mesh.chunk_counts[c] == 0) continue;
+
+        StreamChunk& chunk = cache.Get(mesh, c);
+        ChunkAdjacency(chunk, adj, seams, keys);
+        ApplySeams(adj, keys, seams);
+        CollectHoleEdges(chunk.tris, adj, edges);
+
+        for (int i = 0; i < chunk.removed.size(); i++) kept += !chunk.removed[i];
+    }
+
+    return kept;
+}
+
+// Apo8hkeysh tou montelou (oi koryfes opws sto obj, ta trigwna ana chunk)
+// Epistrefei to plh8os twn trigwnwn pou grafthkan
+int WriteStreamObj(const std::string& file, StreamMesh& mesh, ChunkCache& cache)
+{
+    ofstream out(file.c_str());
+    if (!out) throw std::string("Cannot write file: ") + file;
+
+    string vertex_file = mesh.prefix + "_vertices.bin";
+    FILE* in = fopen(vertex_file.c_str(), "rb");
+    if (!in) throw string("Cannot open ") + vertex_file;
+
+    vector<vec> block(1 << 16);
+    size_t read;
+
+    while ((read = fread(&block[0], sizeof(vec), block.size(), in)) > 0)
+    {
+        for (int i = 0; i < read; i++)
+            out << "v " << block[i].x << " " << block[i].y << " " << block[i].z << "\n";
+    }
+
+    fclose(in);
+
+    int written = 0;
+
+    for (int c = 0; c < mesh.chunk_counts.size(); c++)
+    {
+        if (mesh.chunk_counts[c] == 0) continue;
+
+        StreamChunk& chunk = cache.Get(mesh, c);
+
+        for (int i = 0; i < chunk.tris.size(); i++)
+        {
+            if (chunk.removed[i]) continue;
+
+            const vvr::Triangle& t = chunk.tris[i];
+            out << "f " << chunk.vertex_ids[t.vi1] + 1 << " " << chunk.vertex_ids[t.vi2] + 1 << " " << chunk.vertex_ids[t.vi3] + 1 << "\n";
+            written++;
+        }
+    }
+
+    return written;
+}
+
+// Streaming ekdosh ths RunPipeline: ta montela den fortwnontai pote olokrhra
+// Ta proswrina arxeia grafontai me bash to prefix (<prefix>_1_*, <prefix>_2_*)
+// kai to montelo pou kratame grafetai sto cleaned
+int RunStreamPipeline(const std::string& file_1, const std::string& file_2, const vec& shift1, const vec& shift2, int keep,
+    const std::string& prefix, size_t max_bytes, const std::string& cleaned, std::vector<vvr::LineSeg3D>& edges,
+    std::vector<vvr::LineSeg3D>& loops, std::vector<int>& loop_ends, int& kept)
+{
+    StatTimer timer("RunStreamPipeline");
+
+    StreamMesh mesh_1, mesh_2;
+    BuildStreamMesh(file_1, shift1, prefix + "_1", max_bytes, mesh_1);
+    BuildStreamMesh(file_2, shift2, prefix + "_2", max_bytes, mesh_2);
+
+    ChunkCache cache(max_bytes);
+
+    int collided = StreamCollisions(mesh_2, mesh_1, cache);
+
+    StreamMesh& mesh = (keep == 2) ? mesh_2 : mesh_1;
+
+    cout << "Finding and Cleaning Holes..." << endl;
+    StreamCleaning(mesh, cache, edges);
+    SortEdges(edges, loops, loop_ends);
+
+    kept = WriteStreamObj(cleaned, mesh, cache);
+    cache.Flush();
+
+    RemoveStreamMesh(mesh_1);
+    RemoveStreamMesh(mesh_2);
+
+    return collided > 0;
+}
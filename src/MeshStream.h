@@ -0,0 +1,93 @@
+#pragma once
+
+#include <VVRScene/canvas.h>
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Streaming (out-of-core) ekdosh tou pipeline gia montela pou den xwrane sth mnhmh.
+// To obj diabazetai se kommatia kai ta trigwna moirazontai se ena plegma apo
+// xwrika chunks pou grafontai sto disko. Sth mnhmh fortwnontai mono liga chunks
+// ka8e fora (ChunkCache).
+// Oi rafes metaksy chunks tairiazoun me th welded 8esh twn akrwn tous (opws to
+// EdgeAdjacency), opote to obj den xreiazetai koines koryfes. Ka8e akmh prepei
+// na exei ws 2 trigwna.
+//
+// To orio mnhmhs einai stoxos kai oxi austhro orio:
+// - to plegma den ksepernaei ta STREAM_MAX_GRID kelia ana a3ona, opote se poly
+//   megala montela ena chunk mporei na einai megalytero apo to orio
+// - to ChunkCache krataei panta ta 2 teleytaia chunks, akoma k an den xwrane
+// - oi rafes (SeamTable) kai oi akmes twn opwn kratountai sth mnhmh ektos oriou
+
+// Bytes ana trigwno enos fortwmenou chunk (trigwno, koryfes, adjacency, BVH)
+#define STREAM_TRIANGLE_BYTES 256
+// Megisto plegma chunks ana a3ona
+#define STREAM_MAX_GRID 16
+
+// Trigwno sto arxeio tou chunk: deiktes koryfwn sto obj kai oi 8eseis tous
+struct StreamTriangle
+{
+    uint32_t v[3];
+    float p[9];
+};
+
+// Montelo xwrismeno se chunks sto disko
+struct StreamMesh
+{
+    std::string prefix;
+    int grid;
+    uint64_t vertex_count;
+    uint64_t triangle_count;
+    vvr::Box3D aabb;
+    std::vector<vvr::Box3D> chunk_aabbs;
+    std::vector<uint32_t> chunk_counts;
+};
+
+// Fortwmeno chunk: topikes koryfes (me ton deikth tous sto obj) kai trigwna
+// Ta tris deixnoun sto vertices, opote to chunk den antigrafetai
+struct StreamChunk
+{
+    StreamMesh* mesh;
+    int chunk;
+    int dirty;
+    std::vector<vec> vertices;
+    std::vector<uint32_t> vertex_ids;
+    std::vector<vvr::Triangle> tris;
+    std::vector<char> removed;
+};
+
+// LRU cache apo chunks me stoxo mnhmhs se bytes (ypologismenos me STREAM_TRIANGLE_BYTES)
+// To chunk pou epestrepse h prohgoumenh Get den afaireitai sthn epomenh,
+// wste na mporoun na xrhsimopoioun 2 chunks mazi (p.x. gia ena zeugos)
+class ChunkCache
+{
+public:
+    explicit ChunkCache(size_t max_bytes);
+    ~ChunkCache();
+
+    StreamChunk& Get(StreamMesh& mesh, int chunk);
+    void Flush();
+
+private:
+    void Evict(StreamChunk& chunk);
+
+    size_t max_bytes;
+    size_t bytes;
+    std::list<std::unique_ptr<StreamChunk> > chunks;
+};
+
+// Synarthseis streaming
+void BuildStreamMesh(const std::string& file, const vec& shift, const std::string& prefix, size_t max_bytes, StreamMesh& mesh);
+void LoadStreamChunk(StreamMesh& mesh, int chunk, StreamChunk& data);
+void SaveStreamRemoved(StreamChunk& data);
+void RemoveStreamMesh(StreamMesh& mesh);
+int StreamCollisions(StreamMesh& mesh_1, StreamMesh& mesh_2, ChunkCache& cache);
+int StreamCleaning(StreamMesh& mesh, ChunkCache& cache, std::vector<vvr::LineSeg3D>& edges);
+int WriteStreamObj(const std::string& file, StreamMesh& mesh, ChunkCache& cache);
+int RunStreamPipeline(const std::string& file_1, const std::string& file_2, const vec& shift1, const vec& shift2, int keep,
+    const std::string& prefix, size_t max_bytes, const std::string& cleaned, std::vector<vvr::LineSeg3D>& edges,
+    std::vector<vvr::LineSeg3D>& loops, std::vector<int>& loop_ends, int& kept);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include <vector>
+
+// Opsh (xwris idiokthsia) enos trigwnou: deikths sto buffer twn koryfwn kai
+// oi 3 deiktes. Den antigrafei tipota, opote pernietai me timh stis synarthseis
+// tou narrow phase kai tou cleaning. Ftiaxnetai ki apo vvr::Triangle
+struct TriangleView
+{
+    const vec* vertices;
+    int vi1, vi2, vi3;
+
+    TriangleView(const vec* vertices, int vi1, int vi2, int vi3) : vertices(vertices), vi1(vi1), vi2(vi2), vi3(vi3) {}
+    TriangleView(const vvr::Triangle& t) : vertices(&(*t.vecList)[0]), vi1(t.vi1), vi2(t.vi2), vi3(t.vi3) {}
+
+    const vec& v1() const { return vertices[vi1]; }
+    const vec& v2() const { return vertices[vi2]; }
+    const vec& v3() const { return vertices[vi3]; }
+};
+
+// Opsh (xwris idiokthsia) enos montelou: spans panw sta buffers twn koryfwn
+// kai twn trigwnwn. Oi koryfes mporoun na erxontai apo allo buffer apo ayto
+// twn trigwnwn (p.x. metasxhmatismenes koryfes), xwris antigrafo twn trigwnwn.
+// Ta buffers prepei na zoun oso zei h opsh
+struct MeshView
+{
+    const vec* vertices;
+    int vertex_count;
+    const vvr::Triangle* triangles;
+    int triangle_count;
+
+    MeshView() : vertices(0), vertex_count(0), triangles(0), triangle_count(0) {}
+
+    MeshView(const std::vector<vvr::Triangle>& tris) : vertices(0), vertex_count(0), triangles(0), triangle_count(tris.size())
+    {
+        if (tris.empty()) return;
+        vertices = &(*tris[0].vecList)[0];
+        vertex_count = tris[0].vecList->size();
+        triangles = &tris[0];
+    }
+
+    MeshView(const std::vector<vvr::Triangle>& tris, const std::vector<vec>& verts)
+        : vertices(verts.empty() ? 0 : &verts[0]), vertex_count(verts.size()), triangles(tris.empty() ? 0 : &tris[0]), triangle_count(tris.size()) {}
+
+    MeshView(vvr::Mesh& mesh) : MeshView(mesh.getTriangles(), mesh.getVertices()) {}
+
+    int size() const { return triangle_count; }
+    bool empty() const { return triangle_count == 0; }
+
+    TriangleView operator[](int i) const
+    {
+        const vvr::Triangle& t = triangles[i];
+        return TriangleView(vertices, t.vi1, t.vi2, t.vi3);
+    }
+};
@@ -0,0 +1,135 @@
+#include "MeshWeld.h"
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+using namespace std;
+
+float weld_epsilon = 0;
+
+// To +0.0f enopoiei to -0 me to 0, opws h sygkrish ==
+VertexKey MakeVertexKey(const vec& v)
+{
+    VertexKey k = { v.x + 0.0f, v.y + 0.0f, v.z + 0.0f };
+    return k;
+}
+
+size_t VertexKeyHash::operator()(const VertexKey& k) const
+{
+    uint32_t b[3];
+    memcpy(b, &k.x, sizeof(float));
+    memcpy(b + 1, &k.y, sizeof(float));
+    memcpy(b + 2, &k.z, sizeof(float));
+
+    size_t h = b[0];
+    h = h * 73856093u ^ b[1];
+    h = h * 19349663u ^ b[2];
+    return h;
+}
+
+WeldKey MakeWeldKey(const vec& v, float epsilon)
+{
+    WeldKey k;
+
+    if (epsilon <= 0)
+    {
+        VertexKey e = MakeVertexKey(v);
+        uint32_t b[3];
+        memcpy(b, &e, sizeof(b));
+
+        k.x = b[0];
+        k.y = b[1];
+        k.z = b[2];
+        return k;
+    }
+
+    float inv = 1.0f / epsilon;
+    k.x = (int64_t)floor(v.x * inv);
+    k.y = (int64_t)floor(v.y * inv);
+    k.z = (int64_t)floor(v.z * inv);
+    return k;
+}
+
+// Kleidi tou keliou tou plegmatos (oi sygkrouseis apla pros8etoun elegxous apostashs)
+static uint64_t CellKey(int64_t x, int64_t y, int64_t z)
+{
+    uint64_t h = (uint64_t)x * 73856093u;
+    h ^= (uint64_t)y * 19349663u;
+    h ^= (uint64_t)z * 83492791u;
+    return h;
+}
+
+// Enwsh twn koryfwn pou apexoun ligotero apo epsilon
+// To ids[i] einai to id ths koryfhs i kai to welded[id] h 8esh ths prwths koryfhs tou id
+// Epistrefei to plh8os twn enwmenwn koryfwn
+int WeldVertices(const vector<vec>& vertices, float epsilon, vector<uint32_t>& ids, vector<vec>& welded)
+{
+    ids.resize(vertices.size());
+    welded.clear();
+
+    if (epsilon <= 0)
+    {
+        unordered_map<VertexKey, uint32_t, VertexKeyHash> exact;
+        exact.reserve(vertices.size());
+
+        for (int i = 0; i < vertices.size(); i++)
+        {
+            auto it = exact.insert(make_pair(MakeVertexKey(vertices[i]), (uint32_t)welded.size()));
+            if (it.second) welded.push_back(vertices[i]);
+
+            ids[i] = it.first->second;
+        }
+
+        return welded.size();
+    }
+
+    // Plegma me kelia megethous epsilon: oi koryfes pou enwnontai
+    // brisketai sto idio h se geitoniko keli
+    float inv = 1.0f / epsilon;
+    float eps2 = epsilon * epsilon;
+    unordered_map<uint64_t, int> cells;
+    vector<int> next;
+    cells.reserve(vertices.size());
+
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        const vec& v = vertices[i];
+        int64_t cx = (int64_t)floor(v.x * inv);
+        int64_t cy = (int64_t)floor(v.y * inv);
+        int64_t cz = (int64_t)floor(v.z * inv);
+        int found = -1;
+
+        for (int dx = -1; dx <= 1 && found < 0; dx++)
+        for (int dy = -1; dy <= 1 && found < 0; dy++)
+        for (int dz = -1; dz <= 1 && found < 0; dz++)
+        {
+            auto c = cells.find(CellKey(cx + dx, cy + dy, cz + dz));
+            if (c == cells.end()) continue;
+
+            for (int w = c->second; w >= 0; w = next[w])
+            {
+                vec d = welded[w] - v;
+
+                if (d.x * d.x + d.y * d.y + d.z * d.z <= eps2)
+                {
+                    found = w;
+                    break;
+                }
+            }
+        }
+
+        if (found < 0)
+        {
+            found = welded.size();
+            welded.push_back(v);
+
+            auto c = cells.insert(make_pair(CellKey(cx, cy, cz), -1)).first;
+            next.push_back(c->second);
+            c->second = found;
+        }
+
+        ids[i] = found;
+    }
+
+    return welded.size();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <MathGeoLib.h>
+#include <cstdint>
+#include <vector>
+
+// Kleidi koryfhs: oi koryfes me idia akribws 8esh (isa x, y, z) pairnoun to idio id
+struct VertexKey
+{
+    float x, y, z;
+    bool operator==(const VertexKey& o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+struct VertexKeyHash
+{
+    size_t operator()(const VertexKey& k) const;
+};
+
+// Kleidi ths 8eshs mias koryfhs opws thn kbantizei to WeldVertices:
+// me epsilon <= 0 ta bits twn x, y, z, alliws to keli tou plegmatos floor(v / epsilon)
+struct WeldKey
+{
+    int64_t x, y, z;
+    bool operator==(const WeldKey& o) const { return x == o.x && y == o.y && z == o.z; }
+    bool operator<(const WeldKey& o) const { return x != o.x ? x < o.x : (y != o.y ? y < o.y : z < o.z); }
+};
+
+// Apostash katw apo thn opoia 2 koryfes enwnontai (welding)
+// Me 0 enwnontai mono oi koryfes me idia akribws 8esh
+extern float weld_epsilon;
+
+// Synarthseis welding
+VertexKey MakeVertexKey(const vec& v);
+WeldKey MakeWeldKey(const vec& v, float epsilon);
+int WeldVertices(const std::vector<vec>& vertices, float epsilon, std::vector<uint32_t>& ids, std::vector<vec>& welded);
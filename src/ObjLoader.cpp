@@ -0,0 +1,384 @@
+#include "ObjLoader.h"
+#include "HoleFilling.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// H cache grafei tis koryfes opws einai sth mnhmh
+static_assert(sizeof(vec) == 3 * sizeof(float), "vec must be 3 packed floats");
+
+// // // // // //
+// Mapped file
+// // // // // //
+
+void MapFile(const std::string& file, MappedFile& map)
+{
+    map.data = 0;
+    map.size = 0;
+
+#ifdef _WIN32
+    map.mapping = 0;
+    map.file = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (map.file == INVALID_HANDLE_VALUE) throw string("Cannot open ") + file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(map.file, &size))
+    {
+        UnmapFile(map);
+        throw string("Cannot read the size of ") + file;
+    }
+
+    map.size = size.QuadPart;
+    if (map.size == 0) return;
+
+    map.mapping = CreateFileMappingA(map.file, 0, PAGE_READONLY, 0, 0, 0);
+    if (map.mapping) map.data = (const char*)MapViewOfFile(map.mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    map.fd = open(file.c_str(), O_RDONLY);
+    if (map.fd < 0) throw string("Cannot open ") + file;
+
+    struct stat st;
+    if (fstat(map.fd, &st) != 0)
+    {
+        UnmapFile(map);
+        throw string("Cannot read the size of ") + file;
+    }
+
+    map.size = st.st_size;
+    if (map.size == 0) return;
+
+    void* data = mmap(0, map.size, PROT_READ, MAP_PRIVATE, map.fd, 0);
+    if (data != MAP_FAILED) map.data = (const char*)data;
+#endif
+
+    // To UnmapFile kleinei ta handles/fd pou anoiksan
+    if (!map.data)
+    {
+        UnmapFile(map);
+        throw string("Cannot map ") + file;
+    }
+}
+
+void UnmapFile(MappedFile& map)
+{
+#ifdef _WIN32
+    if (map.data) UnmapViewOfFile(map.data);
+    if (map.mapping) CloseHandle(map.mapping);
+    CloseHandle(map.file);
+#else
+    if (map.data) munmap((void*)map.data, map.size);
+    close(map.fd);
+#endif
+}
+
+// // // // // //
+// OBJ parsing
+// // // // // //
+
+static const char* SkipSpaces(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    return p;
+}
+
+// Diabazei enan float xwris na perasei to telos tou map (to map den teleiwnei me '\0')
+static const char* ParseFloat(const char* p, const char* end, float& value)
+{
+    char buf[64];
+    int n = 0;
+
+    p = SkipSpaces(p, end);
+    while (p < end && n < 63 && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') buf[n++] = *p++;
+    buf[n] = 0;
+
+    value = strtof(buf, 0);
+    return p;
+}
+
+// Diabazei to prwto noumero enos "v/vt/vn" kai prospernaei ta ypoloipa
+static const char* ParseIndex(const char* p, const char* end, int& index, int& ok)
+{
+    p = SkipSpaces(p, end);
+
+    int sign = 1;
+    if (p < end && *p == '-') { sign = -1; p++; }
+
+    ok = p < end && *p >= '0' && *p <= '9';
+    index = 0;
+    while (p < end && *p >= '0' && *p <= '9') index = index * 10 + (*p++ - '0');
+    index *= sign;
+
+    while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') p++;
+    return p;
+}
+
+void ParseObjRange(const char* p, const char* end, ObjChunk& chunk)
+{
+    vector<pair<int, int> > poly;
+
+    while (p < end)
+    {
+        const char* line_end = (const char*)memchr(p, '\n', end - p);
+        if (!line_end) line_end = end;
+
+        if (line_end - p > 1 && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+        {
+            vec v;
+            const char* q = ParseFloat(p + 1, line_end, v.x);
+            q = ParseFloat(q, line_end, v.y);
+            ParseFloat(q, line_end, v.z);
+            chunk.vertices.push_back(v);
+        }
+        else if (line_end - p > 1 && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+        {
+            int index, ok;
+            const char* q = p + 1;
+
+            // Oi arnhtikoi deiktes metrane apo thn teleytaia koryfh prin th grammh
+            poly.clear();
+            while (true)
+            {
+                q = ParseIndex(q, line_end, index, ok);
+                if (!ok) break;
+
+                if (index < 0) poly.push_back(make_pair(chunk.vertices.size() + index, 1));
+                else poly.push_back(make_pair(index - 1, 0));
+            }
+
+            // Polygwna me perissoteres apo 3 koryfes ginontai fan apo trigwna
+            for (int k = 2; k < poly.size(); k++)
+            {
+                int fan[3] = { 0, k - 1, k };
+
+                for (int j = 0; j < 3; j++)
+                {
+                    if (poly[fan[j]].second) chunk.relative.push_back(chunk.indices.size());
+                    chunk.indices.push_back(poly[fan[j]].first);
+                }
+            }
+        }
+
+        p = line_end + 1;
+    }
+}
+
+// Parallhlh anagnwsh tou obj se vertex/index buffers
+// Epistrefei to plh8os twn trigwnwn
+int ParseObj(const std::string& file, std::vector<vec>& vertices, std::vector<uint32_t>& indices)
+{
+    MappedFile map;
+    MapFile(file, map);
+
+    const char* data = map.data;
+    const char* end = map.data + map.size;
+
+    // Ta kommatia xwrizontai se allages grammhs
+    ThreadPool& pool = ThreadPool::Global();
+    int chunks = map.size < (1 << 20) ? 1 : 4 * pool.Size();
+    vector<const char*> bounds(chunks + 1, end);
+    bounds[0] = data;
+
+    for (int c = 1; c < chunks; c++)
+    {
+        const char* p = data + map.size * c / chunks;
+        if (p < bounds[c - 1]) p = bounds[c - 1];
+
+        const char* nl = (const char*)memchr(p, '\n', end - p);
+        bounds[c] = nl ? nl + 1 : end;
+    }
+
+    vector<ObjChunk> parts(chunks);
+
+    pool.ParallelFor(chunks, 1, [&](int thread, int begin, int end) {
+        for (int c = begin; c < end; c++) ParseObjRange(bounds[c], bounds[c + 1], parts[c]);
+    });
+
+    UnmapFile(map);
+
+    // Enwsh twn kommatiwn
+    vertices.clear();
+    indices.clear();
+
+    for (int c = 0; c < chunks; c++)
+    {
+        int base = vertices.size();
+        int first = indices.size();
+        vertices.insert(vertices.end(), parts[c].vertices.begin(), parts[c].vertices.end());
+        indices.insert(indices.end(), parts[c].indices.begin(), parts[c].indices.end());
+
+        for (int r = 0; r < parts[c].relative.size(); r++)
+            indices[first + parts[c].relative[r]] += base;
+    }
+
+    // Oi deiktes elegxontai afou einai gnwstes oles oi koryfes
+    for (int i = 0; i < indices.size(); i++)
+        if (indices[i] >= vertices.size()) throw string("Invalid face index in ") + file;
+
+    return indices.size() / 3;
+}
+
+// // // // // //
+// Binary cache
+// // // // // //
+
+#define OBJ_CACHE_MAGIC 0x434d4648u // "HFMC"
+#define OBJ_CACHE_VERSION 1
+
+struct ObjCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t source_size;
+    int64_t source_time;
+    uint32_t vertex_count;
+    uint32_t index_count;
+    float aabb[6];
+};
+
+// Mege8os kai hmeromhnia tou obj, gia thn akyrwsh ths cache
+static int SourceStamp(const string& file, uint64_t& size, int64_t& time)
+{
+    struct stat st;
+    if (stat(file.c_str(), &st) != 0) return 0;
+
+    size = st.st_size;
+    time = st.st_mtime;
+    return 1;
+}
+
+// Fortwsh apo thn cache, an yparxei kai einai egkyrh gia to obj
+int ReadObjCache(const std::string& file, std::vector<vec>& vertices, std::vector<uint32_t>& indices, vvr::Box3D& aabb)
+{
+    uint64_t size;
+    int64_t time;
+    if (!SourceStamp(file, size, time)) return 0;
+
+    FILE* in = fopen((file + OBJ_CACHE_EXT).c_str(), "rb");
+    if (!in) return 0;
+
+    ObjCacheHeader h;
+    int ok = fread(&h, sizeof(h), 1, in) == 1
+        && h.magic == OBJ_CACHE_MAGIC && h.version == OBJ_CACHE_VERSION
+        && h.source_size == size && h.source_time == time && h.index_count % 3 == 0;
+
+    if (ok)
+    {
+        vertices.resize(h.vertex_count);
+        indices.resize(h.index_count);
+
+        ok = (h.vertex_count == 0 || fread(&vertices[0], sizeof(vec), h.vertex_count, in) == h.vertex_count)
+            && (h.index_count == 0 || fread(&indices[0], sizeof(uint32_t), h.index_count, in) == h.index_count);
+
+        for (int i = 0; ok && i < indices.size(); i++)
+            if (indices[i] >= vertices.size()) ok = 0;
+    }
+
+    fclose(in);
+    if (!ok) return 0;
+
+    aabb.x1 = h.aabb[0];
+    aabb.y1 = h.aabb[1];
+    aabb.z1 = h.aabb[2];
+    aabb.x2 = h.aabb[3];
+    aabb.y2 = h.aabb[4];
+    aabb.z2 = h.aabb[5];
+    return 1;
+}
+
+// Apo8hkeysh ths cache dipla sto obj (an o fakelos den grafetai, h cache paraleipetai)
+void WriteObjCache(const std::string& file, std::vector<vec>& vertices, std::vector<uint32_t>& indices, vvr::Box3D& aabb)
+{
+    ObjCacheHeader h;
+    if (!SourceStamp(file, h.source_size, h.source_time)) return;
+
+    h.magic = OBJ_CACHE_MAGIC;
+    h.version = OBJ_CACHE_VERSION;
+    h.vertex_count = vertices.size();
+    h.index_count = indices.size();
+    h.aabb[0] = aabb.x1;
+    h.aabb[1] = aabb.y1;
+    h.aabb[2] = aabb.z1;
+    h.aabb[3] = aabb.x2;
+    h.aabb[4] = aabb.y2;
+    h.aabb[5] = aabb.z2;
+
+    // Grafetai prwta se proswrino arxeio wste mia misotelh cache na mhn diabastei pote
+    // To onoma exei to pid kai ena metrhth, wste alles diergasies (h alla threads)
+    // pou grafoun thn idia cache na mhn grafoun sto idio arxeio
+    static std::atomic<int> tmp_counter(0);
+    char suffix[64];
+#ifdef _WIN32
+    sprintf(suffix, ".%lu.%d.tmp", (unsigned long)GetCurrentProcessId(), tmp_counter++);
+#else
+    sprintf(suffix, ".%ld.%d.tmp", (long)getpid(), tmp_counter++);
+#endif
+
+    string cache = file + OBJ_CACHE_EXT;
+    string tmp = cache + suffix;
+    FILE* out = fopen(tmp.c_str(), "wb");
+    if (!out) return;
+
+    int ok = fwrite(&h, sizeof(h), 1, out) == 1
+        && (vertices.empty() || fwrite(&vertices[0], sizeof(vec), vertices.size(), out) == vertices.size())
+        && (indices.empty() || fwrite(&indices[0], sizeof(uint32_t), indices.size(), out) == indices.size());
+
+    ok = (fclose(out) == 0) && ok;
+
+    // H antikatastash ths palias cache einai atomikh, opote panta yparxei mia plhrhs cache
+#ifdef _WIN32
+    if (!ok || !MoveFileExA(tmp.c_str(), cache.c_str(), MOVEFILE_REPLACE_EXISTING)) remove(tmp.c_str());
+#else
+    if (!ok || rename(tmp.c_str(), cache.c_str()) != 0) remove(tmp.c_str());
+#endif
+}
+
+// // // // // //
+// Mesh
+// // // // // //
+
+// Fortwsh tou obj sto mesh, apo thn cache an einai egkyrh
+// To aabb (an dw8ei) pairnei to AABB twn koryfwn tou arxeiou
+// Epistrefei 1 an to mesh fortw8hke apo thn cache
+int LoadObj(const std::string& file, vvr::Mesh& mesh, vvr::Box3D* aabb, int use_cache)
+{
+    vector<vec>& vertices = mesh.getVertices();
+    vector<vvr::Triangle>& tris = mesh.getTriangles();
+    vector<uint32_t> indices;
+    vvr::Box3D box;
+
+    vertices.clear();
+    tris.clear();
+
+    int cached = use_cache && ReadObjCache(file, vertices, indices, box);
+
+    if (!cached)
+    {
+        ParseObj(file, vertices, indices);
+        if (vertices.empty()) throw string("No vertices in ") + file;
+
+        CalcAABB(vertices, box);
+        if (use_cache) WriteObjCache(file, vertices, indices, box);
+    }
+
+    tris.reserve(indices.size() / 3);
+    for (int i = 0; i + 2 < indices.size(); i += 3)
+        tris.push_back(vvr::Triangle(&vertices, indices[i], indices[i + 1], indices[i + 2]));
+
+    mesh.update();
+
+    if (aabb) *aabb = box;
+    return cached;
+}
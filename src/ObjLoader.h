@@ -0,0 +1,44 @@
+#pragma once
+
+#include <VVRScene/canvas.h>
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Grhgorh fortwsh OBJ: to arxeio ginetai map sth mnhmh kai xwrizetai se
+// kommatia pou diabazontai parallhla. To apotelesma grafetai se binary cache
+// (<obj>.hfcache) me vertex/index buffers kai to AABB, wste oi epomenes
+// ekteleseis na mhn 3anadiabazoun to keimeno. H cache akyrwnetai otan
+// allaksei to mege8os h h hmeromhnia tou obj.
+#define OBJ_CACHE_EXT ".hfcache"
+
+// Anagnwsh tou arxeiou mesw mmap (MapViewOfFile sta Windows)
+struct MappedFile
+{
+    const char* data;
+    size_t size;
+    void* file;
+    void* mapping;
+    int fd;
+};
+
+// Apotelesma enos kommatiou: oi 8etikoi deiktes ginontai 0-based amesws,
+// enw oi arnhtikoi (sxetikoi) krataoun th 8esh tous sto kommati (relative)
+// mexri na ginei gnwsto to plh8os twn koryfwn prin apo ayto
+struct ObjChunk
+{
+    std::vector<vec> vertices;
+    std::vector<int> indices;
+    std::vector<int> relative;
+};
+
+// Synarthseis fortwshs
+void MapFile(const std::string& file, MappedFile& map);
+void UnmapFile(MappedFile& map);
+void ParseObjRange(const char* p, const char* end, ObjChunk& chunk);
+int LoadObj(const std::string& file, vvr::Mesh& mesh, vvr::Box3D* aabb = 0, int use_cache = 1);
+int ParseObj(const std::string& file, std::vector<vec>& vertices, std::vector<uint32_t>& indices);
+int ReadObjCache(const std::string& file, std::vector<vec>& vertices, std::vector<uint32_t>& indices, vvr::Box3D& aabb);
+void WriteObjCache(const std::string& file, std::vector<vec>& vertices, std::vector<uint32_t>& indices, vvr::Box3D& aabb);
@@ -0,0 +1,450 @@
+#include "PatchFairing.h"
+#include "PipelineStats.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+// Oi grammes se batches sto pool h oles sto idio thread
+static void ForRows(int rows, int parallel, const function<void(int, int, int)>& task)
+{
+    if (parallel) ThreadPool::Global().ParallelFor(rows, 1024, task);
+    else task(0, 0, rows);
+}
+
+// // // // // //
+// Sparse
+// // // // // //
+
+// y = A x gia 3 sthles (oi syntetagmenes ka8e grammhs einai synexomenes)
+void MultiplySparse(const SparseMatrix& A, const std::vector<float>& x, std::vector<float>& y, int parallel)
+{
+    y.assign(3 * A.rows, 0);
+
+    ForRows(A.rows, parallel, [&](int thread, int first, int last) {
+        for (int i = first; i < last; i++)
+        {
+            float s0 = 0, s1 = 0, s2 = 0;
+
+            for (int e = A.offsets[i]; e < A.offsets[i + 1]; e++)
+            {
+                const float* xj = &x[3 * A.columns[e]];
+                s0 += A.values[e] * xj[0];
+                s1 += A.values[e] * xj[1];
+                s2 += A.values[e] * xj[2];
+            }
+
+            y[3 * i] = s0;
+            y[3 * i + 1] = s1;
+            y[3 * i + 2] = s2;
+        }
+    });
+}
+
+// Conjugate gradient me Jacobi preconditioner gia A x = b, me 3 stiles pou
+// lynontai mazi (koino A p, ksexwrista alpha kai beta ana syntetagmenh)
+// To x einai h arxikh lysh. Epistrefei tis epanalhpseis
+int SolveCG(const SparseMatrix& A, const std::vector<float>& inv_diagonal, const std::vector<float>& b, std::vector<float>& x, int parallel)
+{
+    int n = A.rows;
+    if (n == 0) return 0;
+
+    int threads = parallel ? ThreadPool::Global().Size() : 1;
+    vector<float> r, z(3 * n), p(3 * n), q(3 * n);
+    vector<double> partial(3 * threads), partial_rr(3 * threads);
+
+    // Ta merika a8roismata ana thread, gia na mhn yparxoun koina atomics
+    auto sum = [&](double* total) {
+        total[0] = total[1] = total[2] = 0;
+        for (int t = 0; t < threads; t++)
+            for (int c = 0; c < 3; c++) total[c] += partial[3 * t + c];
+        std::fill(partial.begin(), partial.end(), 0.0);
+    };
+
+    double rz[3], bb[3], pq[3], rr[3];
+
+    // r = b - A x, z = M^-1 r, p = z
+    MultiplySparse(A, x, r, parallel);
+    std::fill(partial.begin(), partial.end(), 0.0);
+
+    ForRows(n, parallel, [&](int thread, int first, int last) {
+        for (int i = first; i < last; i++)
+            for (int c = 0; c < 3; c++)
+            {
+                int k = 3 * i + c;
+                r[k] = b[k] - r[k];
+                z[k] = inv_diagonal[i] * r[k];
+                p[k] = z[k];
+                partial[3 * thread + c] += (double)r[k] * z[k];
+            }
+    });
+    sum(rz);
+
+    ForRows(n, parallel, [&](int thread, int first, int last) {
+        for (int k = 3 * first; k < 3 * last; k++) partial[3 * thread + k % 3] += (double)b[k] * b[k];
+    });
+    sum(bb);
+
+    double tolerance = (double)FAIR_TOLERANCE * FAIR_TOLERANCE;
+    int iteration = 0;
+
+    while (iteration < FAIR_MAX_ITERATIONS)
+    {
+        if (rz[0] == 0 && rz[1] == 0 && rz[2] == 0) break;
+        iteration++;
+
+        // q = A p kai p . q
+        ForRows(n, parallel, [&](int thread, int first, int last) {
+            for (int i = first; i < last; i++)
+            {
+                float s0 = 0, s1 = 0, s2 = 0;
+
+                for (int e = A.offsets[i]; e < A.offsets[i + 1]; e++)
+                {
+                    const float* pj = &p[3 * A.columns[e]];
+                    s0 += A.values[e] * pj[0];
+                    s1 += A.values[e] * pj[1];
+                    s2 += A.values[e] * pj[2];
+                }
+
+                q[3 * i] = s0;
+                q[3 * i + 1] = s1;
+                q[3 * i + 2] = s2;
+
+                partial[3 * thread] += (double)p[3 * i] * s0;
+                partial[3 * thread + 1] += (double)p[3 * i + 1] * s1;
+                partial[3 * thread + 2] += (double)p[3 * i + 2] * s2;
+            }
+        });
+        sum(pq);
+
+        float alpha[3];
+        for (int c = 0; c < 3; c++) alpha[c] = pq[c] != 0 ? (float)(rz[c] / pq[c]) : 0;
+
+        // x += alpha p, r -= alpha q, z = M^-1 r
+        std::fill(partial_rr.begin(), partial_rr.end(), 0.0);
+
+        ForRows(n, parallel, [&](int thread, int first, int last) {
+            for (int i = first; i < last; i++)
+                for (int c = 0; c < 3; c++)
+                {
+                    int k = 3 * i + c;
+                    x[k] += alpha[c] * p[k];
+                    r[k] -= alpha[c] * q[k];
+                    z[k] = inv_diagonal[i] * r[k];
+                    partial[3 * thread + c] += (double)r[k] * z[k];
+                    partial_rr[3 * thread + c] += (double)r[k] * r[k];
+                }
+        });
+
+        double rz_new[3];
+        sum(rz_new);
+
+        int converged = 1;
+        for (int c = 0; c < 3; c++)
+        {
+            rr[c] = 0;
+            for (int t = 0; t < threads; t++) rr[c] += partial_rr[3 * t + c];
+            if (rr[c] > tolerance * max(bb[c], 1e-30)) converged = 0;
+        }
+
+        if (converged) break;
+
+        float beta[3];
+        for (int c = 0; c < 3; c++)
+        {
+            beta[c] = rz[c] != 0 ? (float)(rz_new[c] / rz[c]) : 0;
+            rz[c] = rz_new[c];
+        }
+
+        // p = z + beta p
+        ForRows(n, parallel, [&](int thread, int first, int last) {
+            for (int k = 3 * first; k < 3 * last; k++) p[k] = z[k] + beta[k % 3] * p[k];
+        });
+    }
+
+    return iteration;
+}
+
+// // // // // //
+// Systhmata
+// // // // // //
+
+// Hash ths topologias tou patch (FNV-1a sta trigwna kai ston typo)
+uint64_t PatchTopology(const std::vector<vvr::Triangle>& tris, int begin, int end, int mode)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    auto mix = [&](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    mix(mode);
+    mix(end - begin);
+
+    for (int t = begin; t < end; t++)
+    {
+        mix(tris[t].vi1);
+        mix(tris[t].vi2);
+        mix(tris[t].vi3);
+    }
+
+    return hash;
+}
+
+// Xtisimo tou A x_I = C x_B gia ta trigwna [begin, end) tou tris
+// Oria einai oi koryfes twn akmwn pou anhkoun se ena mono trigwno tou patch.
+// FAIR_LAPLACIAN: A = K_II kai C = -K_IB, me K = D - Adj (grafos tou patch)
+// FAIR_BILAPLACIAN: A = L_I^T L_I kai C = -L_I^T L_B, me L = D^-1 K se oles tis koryfes
+void BuildFairingSystem(const std::vector<vvr::Triangle>& tris, int begin, int end, int mode, FairingSystem& system)
+{
+    system.topology = PatchTopology(tris, begin, end, mode);
+    system.mode = mode;
+    system.interior.clear();
+    system.boundary.clear();
+
+    // Topikes koryfes
+    unordered_map<int, int> local;
+    vector<int> globals;
+    vector<int> triangles;
+
+    for (int t = begin; t < end; t++)
+    {
+        int v[3] = { tris[t].vi1, tris[t].vi2, tris[t].vi3 };
+
+        for (int k = 0; k < 3; k++)
+        {
+            auto it = local.insert(make_pair(v[k], (int)globals.size()));
+            if (it.second) globals.push_back(v[k]);
+            triangles.push_back(it.first->second);
+        }
+    }
+
+    int n = globals.size();
+
+    // Akmes xwris antistrofh sto patch = oria
+    unordered_set<uint64_t> directed;
+    vector<pair<int, int> > pairs;
+
+    for (int i = 0; i < triangles.size(); i += 3)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            int a = triangles[i + k], b = triangles[i + (k + 1) % 3];
+            directed.insert(((uint64_t)a << 32) | (uint32_t)b);
+            pairs.push_back(make_pair(a, b));
+            pairs.push_back(make_pair(b, a));
+        }
+    }
+
+    vector<char> fixed(n, 0);
+    for (int i = 0; i < triangles.size(); i += 3)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            int a = triangles[i + k], b = triangles[i + (k + 1) % 3];
+            if (!directed.count(((uint64_t)b << 32) | (uint32_t)a)) fixed[a] = fixed[b] = 1;
+        }
+    }
+
+    // Geitones ana koryfh (CSR)
+    sort(pairs.begin(), pairs.end());
+    pairs.erase(unique(pairs.begin(), pairs.end()), pairs.end());
+
+    vector<int> nbr_offsets(n + 1, 0);
+    vector<int> nbr(pairs.size());
+    for (int e = 0; e < pairs.size(); e++)
+    {
+        nbr_offsets[pairs[e].first + 1]++;
+        nbr[e] = pairs[e].second;
+    }
+    for (int v = 0; v < n; v++) nbr_offsets[v + 1] += nbr_offsets[v];
+
+    vector<int> index(n);
+    for (int v = 0; v < n; v++)
+    {
+        if (fixed[v])
+        {
+            index[v] = system.boundary.size();
+            system.boundary.push_back(globals[v]);
+        }
+        else
+        {
+            index[v] = system.interior.size();
+            system.interior.push_back(globals[v]);
+        }
+    }
+
+    SparseMatrix& A = system.A;
+    SparseMatrix& C = system.C;
+    A.rows = A.cols = C.rows = system.interior.size();
+    C.cols = system.boundary.size();
+    A.offsets.assign(1, 0);
+    C.offsets.assign(1, 0);
+    A.columns.clear(); A.values.clear();
+    C.columns.clear(); C.values.clear();
+    system.inv_diagonal.assign(A.rows, 1);
+
+    // Pyknos accumulator gia mia grammh
+    vector<float> acc(n, 0);
+    vector<char> mark(n, 0);
+    vector<int> touched;
+
+    auto add = [&](int v, float value) {
+        if (!mark[v])
+        {
+            mark[v] = 1;
+            touched.push_back(v);
+        }
+        acc[v] += value;
+    };
+
+    // L[r][j] me L = D^-1 K
+    auto laplacian = [&](int r, int j) {
+        return (r == j) ? 1.0f : -1.0f / (nbr_offsets[r + 1] - nbr_offsets[r]);
+    };
+
+    for (int v = 0; v < n; v++)
+    {
+        if (fixed[v]) continue;
+
+        if (mode == FAIR_BILAPLACIAN)
+        {
+            // Grammes r tou L me mh mhdeniko L[r][v]: h v kai oi geitones ths
+            auto row = [&](int r) {
+                float lrv = laplacian(r, v);
+
+                add(r, lrv * laplacian(r, r));
+                for (int f = nbr_offsets[r]; f < nbr_offsets[r + 1]; f++)
+                    add(nbr[f], lrv * laplacian(r, nbr[f]));
+            };
+
+            row(v);
+            for (int e = nbr_offsets[v]; e < nbr_offsets[v + 1]; e++) row(nbr[e]);
+        }
+        else
+        {
+            add(v, nbr_offsets[v + 1] - nbr_offsets[v]);
+            for (int e = nbr_offsets[v]; e < nbr_offsets[v + 1]; e++) add(nbr[e], -1);
+        }
+
+        for (int t = 0; t < touched.size(); t++)
+        {
+            int j = touched[t];
+
+            if (fixed[j])
+            {
+                C.columns.push_back(index[j]);
+                C.values.push_back(-acc[j]);
+            }
+            else
+            {
+                A.columns.push_back(index[j]);
+                A.values.push_back(acc[j]);
+                if (j == v && acc[j] != 0) system.inv_diagonal[index[v]] = 1 / acc[j];
+            }
+
+            acc[j] = 0;
+            mark[j] = 0;
+        }
+
+        touched.clear();
+        A.offsets.push_back(A.columns.size());
+        C.offsets.push_back(C.columns.size());
+    }
+}
+
+// // // // // //
+// Opes
+// // // // // //
+
+// Fairing olwn twn patches tou FillHoles / RefineHoles
+// To patch l einai ta tris[patch_ends[l - 1]..patch_ends[l]) me to prwto na arxizei sto first
+// Ta systhmata tou cache ksanaxtizontai mono an allakse h topologia tou patch
+// Epistrefei to plh8os twn koryfwn pou metakinh8hkan
+int FairHoles(std::vector<vvr::Triangle>& tris, int first, const std::vector<int>& patch_ends, int mode, FairingCache& cache)
+{
+    StatTimer timer("FairHoles");
+
+    int holes = patch_ends.size();
+    if (holes == 0 || first >= tris.size()) return 0;
+
+    vector<vec>& vertices = *tris[first].vecList;
+    ThreadPool& pool = ThreadPool::Global();
+
+    cache.systems.resize(holes);
+    vector<char> rebuilt(holes, 0);
+    vector<int> iterations(holes, 0);
+
+    pool.ParallelFor(holes, 1, [&](int thread, int begin_l, int end_l) {
+        for (int l = begin_l; l < end_l; l++)
+        {
+            int begin = (l == 0) ? first : patch_ends[l - 1];
+            FairingSystem& system = cache.systems[l];
+
+            if (system.mode == mode && system.topology == PatchTopology(tris, begin, patch_ends[l], mode)) continue;
+
+            BuildFairingSystem(tris, begin, patch_ends[l], mode, system);
+            rebuilt[l] = 1;
+        }
+    });
+
+    // Lysh enos patch: deksi melos apo ta oria kai arxikh lysh oi trexouses 8eseis
+    auto solve = [&](int l, int parallel) {
+        FairingSystem& system = cache.systems[l];
+        int ni = system.interior.size();
+        int nb = system.boundary.size();
+        if (ni == 0) return;
+
+        vector<float> xb(3 * nb), b, x(3 * ni);
+
+        for (int i = 0; i < nb; i++)
+        {
+            const vec& v = vertices[system.boundary[i]];
+            xb[3 * i] = v.x; xb[3 * i + 1] = v.y; xb[3 * i + 2] = v.z;
+        }
+
+        for (int i = 0; i < ni; i++)
+        {
+            const vec& v = vertices[system.interior[i]];
+            x[3 * i] = v.x; x[3 * i + 1] = v.y; x[3 * i + 2] = v.z;
+        }
+
+        MultiplySparse(system.C, xb, b, parallel);
+        iterations[l] = SolveCG(system.A, system.inv_diagonal, b, x, parallel);
+
+        for (int i = 0; i < ni; i++)
+            vertices[system.interior[i]] = vec(x[3 * i], x[3 * i + 1], x[3 * i + 2]);
+    };
+
+    // Mikra patches parallhla (ena ana thread), megala me parallhlo CG
+    vector<int> small, large;
+    for (int l = 0; l < holes; l++)
+    {
+        if (cache.systems[l].interior.size() < FAIR_PARALLEL_MIN) small.push_back(l);
+        else large.push_back(l);
+    }
+
+    pool.ParallelFor(small.size(), 1, [&](int thread, int first_s, int last_s) {
+        for (int s = first_s; s < last_s; s++) solve(small[s], 0);
+    });
+
+    for (int i = 0; i < large.size(); i++) solve(large[i], 1);
+
+    int moved = 0, total = 0;
+    for (int l = 0; l < holes; l++)
+    {
+        moved += cache.systems[l].interior.size();
+        total += iterations[l];
+        if (rebuilt[l]) cache.built++;
+        else cache.reused++;
+    }
+
+    cache.iterations += total;
+    STAT_ADD(STAT_CG_ITERATIONS, total);
+
+    return moved;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include <cstdint>
+#include <vector>
+
+// Leiansh (fairing) twn eswterikwn koryfwn tou gemismatos me stathero to orio ths ophs.
+// Me FAIR_LAPLACIAN lynetai to L x = 0 (harmonic), me FAIR_BILAPLACIAN to
+// elaxisto tou |L x|^2 (L^T L x = 0), pou dinei pio omalh epifaneia.
+// Ta systhmata einai sparse (CSR), symmetrika kai 8etika orismena, kai lynontai
+// me conjugate gradient (Jacobi preconditioner) gia tis 3 syntetagmenes mazi.
+// Oi mikres opes lynontai parallhla (mia ana thread), enw oi megales mia mia
+// me parallhlo CG. Ta systhmata kratountai sto FairingCache kai ksanaxrhsimopoiountai
+// oso h topologia tou patch den allazei (allazei mono to deksi melos).
+#define FAIR_LAPLACIAN      1
+#define FAIR_BILAPLACIAN    2
+
+// Agnwstoi ana patch apo tous opoious o CG trexei parallhla
+#define FAIR_PARALLEL_MIN   4096
+#define FAIR_MAX_ITERATIONS 2000
+#define FAIR_TOLERANCE      1e-5f
+
+// Araios pinakas se morfh CSR: h grammh i einai ta [offsets[i], offsets[i + 1])
+struct SparseMatrix
+{
+    int rows;
+    int cols;
+    std::vector<int> offsets;
+    std::vector<int> columns;
+    std::vector<float> values;
+};
+
+// Systhma enos patch: A x_I = C x_B
+// Ta interior kai boundary einai deiktes koryfwn tou montelou
+struct FairingSystem
+{
+    uint64_t topology;
+    int mode;
+    std::vector<int> interior;
+    std::vector<int> boundary;
+    SparseMatrix A;
+    SparseMatrix C;
+    std::vector<float> inv_diagonal;
+};
+
+// Systhmata ana oph apo thn prohgoumenh klhsh ths FairHoles
+struct FairingCache
+{
+    std::vector<FairingSystem> systems;
+    int built;
+    int reused;
+    int iterations;
+
+    FairingCache() : built(0), reused(0), iterations(0) {}
+};
+
+// Synarthseis fairing
+void MultiplySparse(const SparseMatrix& A, const std::vector<float>& x, std::vector<float>& y, int parallel);
+int SolveCG(const SparseMatrix& A, const std::vector<float>& inv_diagonal, const std::vector<float>& b, std::vector<float>& x, int parallel);
+uint64_t PatchTopology(const std::vector<vvr::Triangle>& tris, int begin, int end, int mode);
+void BuildFairingSystem(const std::vector<vvr::Triangle>& tris, int begin, int end, int mode, FairingSystem& system);
+int FairHoles(std::vector<vvr::Triangle>& tris, int first, const std::vector<int>& patch_ends, int mode, FairingCache& cache);
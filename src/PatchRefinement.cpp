@@ -0,0 +1,344 @@
+#include "PatchRefinement.h"
+#include "PipelineStats.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+static uint64_t PatchEdgeKey(int a, int b)
+{
+    if (a > b) swap(a, b);
+    return ((uint64_t)a << 32) | (uint32_t)b;
+}
+
+static float Angle(const vec& a, const vec& b, const vec& c)
+{
+    // Gwnia sthn koryfh c tou trigwnou (a, b, c)
+    vec u = a - c, v = b - c;
+    float lu = u.Length(), lv = v.Length();
+    if (lu == 0 || lv == 0) return 0;
+
+    return acos(max(-1.0f, min(1.0f, u.Dot(v) / (lu * lv))));
+}
+
+// Topiko patch: ta trigwna ws 3 deiktes kai o geitonas ana akmh
+// H akmh k tou trigwnou t einai h (tri[3t + k], tri[3t + (k + 1) % 3])
+// kai nbr[3t + k] to trigwno sthn allh ths meria (-1 sta oria ths ophs)
+struct LocalPatch
+{
+    vector<vec>& points;
+    vector<float> scale;
+    vector<int>& tri;
+    vector<int> nbr;
+    unordered_set<uint64_t> edges;
+    int fixed;
+
+    LocalPatch(vector<vec>& points, vector<int>& tri, int fixed) : points(points), tri(tri), fixed(fixed) {}
+
+    void Replace(int t, int old_nbr, int new_nbr)
+    {
+        if (t < 0) return;
+
+        for (int k = 0; k < 3; k++)
+            if (nbr[3 * t + k] == old_nbr) nbr[3 * t + k] = new_nbr;
+    }
+
+    void Split(int t);
+    int Flip(int t, int k);
+    void Relax(vector<int>& work);
+};
+
+// Xwrismos tou t = (a, b, c) sto kentro baroys m se (a, b, m), (b, c, m), (c, a, m)
+void LocalPatch::Split(int t)
+{
+    int a = tri[3 * t], b = tri[3 * t + 1], c = tri[3 * t + 2];
+    int n1 = nbr[3 * t + 1], n2 = nbr[3 * t + 2];
+
+    int m = points.size();
+    points.push_back((points[a] + points[b] + points[c]) / 3);
+    scale.push_back((scale[a] + scale[b] + scale[c]) / 3);
+
+    int t1 = tri.size() / 3;
+    int t2 = t1 + 1;
+
+    tri[3 * t + 2] = m;
+    tri.push_back(b); tri.push_back(c); tri.push_back(m);
+    tri.push_back(c); tri.push_back(a); tri.push_back(m);
+
+    nbr[3 * t + 1] = t1;
+    nbr[3 * t + 2] = t2;
+    nbr.push_back(n1); nbr.push_back(t2); nbr.push_back(t);
+    nbr.push_back(n2); nbr.push_back(t); nbr.push_back(t1);
+
+    Replace(n1, t, t1);
+    Replace(n2, t, t2);
+
+    edges.insert(PatchEdgeKey(a, m));
+    edges.insert(PatchEdgeKey(b, m));
+    edges.insert(PatchEdgeKey(c, m));
+}
+
+// Flip ths akmhs k tou t an den einai topika Delaunay
+// (a8roisma twn apenanti gwniwn > pi). Epistrefei 1 an egine flip
+int LocalPatch::Flip(int t, int k)
+{
+    int u = nbr[3 * t + k];
+    if (u < 0) return 0;
+
+    int a = tri[3 * t + k], b = tri[3 * t + (k + 1) % 3], c = tri[3 * t + (k + 2) % 3];
+
+    int j = 0;
+    while (j < 3 && !(tri[3 * u + j] == b && tri[3 * u + (j + 1) % 3] == a)) j++;
+    if (j == 3) return 0;
+
+    int d = tri[3 * u + (j + 2) % 3];
+
+    // Nees akmes mono pros eswterikes koryfes: oi diagwnies metaksy koryfwn
+    // ths ophs mporei na yparxoun hdh sto montelo
+    if (c == d || (c < fixed && d < fixed)) return 0;
+    if (edges.count(PatchEdgeKey(c, d))) return 0;
+
+    const vec& pa = points[a];
+    const vec& pb = points[b];
+    const vec& pc = points[c];
+    const vec& pd = points[d];
+
+    if (Angle(pa, pb, pc) + Angle(pb, pa, pd) <= 3.14159265f) return 0;
+
+    // Ta nea trigwna prepei na exoun ton idio prosanatolismo me ta palia
+    vec normal = (pb - pa).Cross(pc - pa) + (pa - pb).Cross(pd - pb);
+    if ((pd - pa).Cross(pc - pa).Dot(normal) <= 0) return 0;
+    if ((pb - pd).Cross(pc - pd).Dot(normal) <= 0) return 0;
+
+    int nbc = nbr[3 * t + (k + 1) % 3];
+    int nca = nbr[3 * t + (k + 2) % 3];
+    int nad = nbr[3 * u + (j + 1) % 3];
+    int ndb = nbr[3 * u + (j + 2) % 3];
+
+    // t = (a, d, c), u = (d, b, c)
+    tri[3 * t] = a; tri[3 * t + 1] = d; tri[3 * t + 2] = c;
+    tri[3 * u] = d; tri[3 * u + 1] = b; tri[3 * u + 2] = c;
+
+    nbr[3 * t] = nad; nbr[3 * t + 1] = u; nbr[3 * t + 2] = nca;
+    nbr[3 * u] = ndb; nbr[3 * u + 1] = nbc; nbr[3 * u + 2] = t;
+
+    Replace(nad, u, t);
+    Replace(nbc, t, u);
+
+    edges.erase(PatchEdgeKey(a, b));
+    edges.insert(PatchEdgeKey(c, d));
+
+    return 1;
+}
+
+// Xalarwsh me lista ergasiwn: ta trigwna pou allazoun ksanaelegxontai
+// Se 3D ta flips den termatizoun panta, opote yparxei orio
+void LocalPatch::Relax(vector<int>& work)
+{
+    int budget = 16 * (tri.size() / 3) + 64;
+
+    while (!work.empty() && budget-- > 0)
+    {
+        int t = work.back();
+        work.pop_back();
+
+        for (int k = 0; k < 3; k++)
+        {
+            int u = nbr[3 * t + k];
+
+            if (Flip(t, k))
+            {
+                work.push_back(t);
+                work.push_back(u);
+                break;
+            }
+        }
+    }
+
+    work.clear();
+}
+
+// Pykn8wsh enos patch se topikes syntetagmenes
+// Oi prwtes fixed koryfes einai ths ophs kai den metakinountai, oi nees
+// prosti8entai sto telos tou points. Epistrefei to plh8os twn newn koryfwn
+int RefinePatch(std::vector<vec>& points, int fixed, std::vector<int>& triangles)
+{
+    int count = triangles.size() / 3;
+    if (count == 0) return 0;
+
+    LocalPatch patch(points, triangles, fixed);
+    patch.nbr.assign(3 * count, -1);
+
+    // Geitniash tou patch apo tis katey8ynomenes akmes
+    unordered_map<uint64_t, int> directed;
+    directed.reserve(3 * count);
+
+    for (int t = 0; t < count; t++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            int a = triangles[3 * t + k], b = triangles[3 * t + (k + 1) % 3];
+            directed[((uint64_t)a << 32) | (uint32_t)b] = 3 * t + k;
+            patch.edges.insert(PatchEdgeKey(a, b));
+        }
+    }
+
+    for (int t = 0; t < count; t++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            int a = triangles[3 * t + k], b = triangles[3 * t + (k + 1) % 3];
+            auto it = directed.find(((uint64_t)b << 32) | (uint32_t)a);
+            if (it != directed.end()) patch.nbr[3 * t + k] = it->second / 3;
+        }
+    }
+
+    // Klimaka twn koryfwn ths ophs: meso mhkos twn akmwn ths ophs sthn koryfh
+    vector<int> degree(points.size(), 0);
+    patch.scale.assign(points.size(), 0);
+    float total = 0;
+    int boundary = 0;
+
+    for (int t = 0; t < count; t++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            if (patch.nbr[3 * t + k] >= 0) continue;
+
+            int a = triangles[3 * t + k], b = triangles[3 * t + (k + 1) % 3];
+            float length = points[a].Distance(points[b]);
+            patch.scale[a] += length; degree[a]++;
+            patch.scale[b] += length; degree[b]++;
+            total += length;
+            boundary++;
+        }
+    }
+
+    if (boundary == 0) return 0;
+
+    for (int v = 0; v < points.size(); v++)
+        patch.scale[v] = degree[v] ? patch.scale[v] / degree[v] : total / boundary;
+
+    int created = 0;
+    vector<int> work;
+
+    // Prwta mia xalarwsh tou arxikou patch
+    for (int t = 0; t < count; t++) work.push_back(t);
+    patch.Relax(work);
+
+    for (int round = 0; round < REFINE_MAX_ROUNDS; round++)
+    {
+        int split = 0;
+        int size = triangles.size() / 3;
+
+        for (int t = 0; t < size; t++)
+        {
+            int v[3] = { triangles[3 * t], triangles[3 * t + 1], triangles[3 * t + 2] };
+            vec center = (points[v[0]] + points[v[1]] + points[v[2]]) / 3;
+            float s = (patch.scale[v[0]] + patch.scale[v[1]] + patch.scale[v[2]]) / 3;
+
+            int accept = 1;
+            for (int k = 0; k < 3 && accept; k++)
+            {
+                float d = REFINE_ALPHA * center.Distance(points[v[k]]);
+                if (d <= s || d <= patch.scale[v[k]]) accept = 0;
+            }
+
+            if (!accept) continue;
+
+            int first = triangles.size() / 3;
+            patch.Split(t);
+            split++;
+
+            // Xalarwsh twn akmwn tou arxikou trigwnou
+            work.push_back(t);
+            work.push_back(first);
+            work.push_back(first + 1);
+            patch.Relax(work);
+        }
+
+        if (!split) break;
+        created += split;
+
+        for (int t = 0; t < triangles.size() / 3; t++) work.push_back(t);
+        patch.Relax(work);
+    }
+
+    return created;
+}
+
+// Pykn8wsh olwn twn patches tou FillHoles (parallhla, ena patch ana task)
+// To patch l einai ta tris[patch_ends[l - 1]..patch_ends[l]) me to prwto na arxizei sto first
+// Ta patches antikay8istantai sto telos tou tris kai to patch_ends enhmerwnetai
+// Epistrefei to plh8os twn newn koryfwn
+int RefineHoles(std::vector<vvr::Triangle>& tris, int first, std::vector<int>& patch_ends)
+{
+    StatTimer timer("RefineHoles");
+
+    int holes = patch_ends.size();
+    if (holes == 0 || first >= tris.size()) return 0;
+
+    vector<vec>* vertices = tris[first].vecList;
+
+    // Ana patch: oi koryfes tou montelou (oi prwtes fixed) kai ta topika trigwna
+    vector<vector<int> > originals(holes);
+    vector<vector<vec> > points(holes);
+    vector<vector<int> > triangles(holes);
+    vector<int> fixed(holes, 0);
+
+    ThreadPool::Global().ParallelFor(holes, 1, [&](int thread, int begin_l, int end_l) {
+        for (int l = begin_l; l < end_l; l++)
+        {
+            int begin = (l == 0) ? first : patch_ends[l - 1];
+            unordered_map<int, int> local;
+
+            for (int t = begin; t < patch_ends[l]; t++)
+            {
+                int v[3] = { tris[t].vi1, tris[t].vi2, tris[t].vi3 };
+
+                for (int k = 0; k < 3; k++)
+                {
+                    auto it = local.insert(make_pair(v[k], (int)originals[l].size()));
+                    if (it.second)
+                    {
+                        originals[l].push_back(v[k]);
+                        points[l].push_back((*vertices)[v[k]]);
+                    }
+
+                    triangles[l].push_back(it.first->second);
+                }
+            }
+
+            fixed[l] = points[l].size();
+            RefinePatch(points[l], fixed[l], triangles[l]);
+        }
+    });
+
+    // Oi nees koryfes mpainoun sto montelo me th seira twn patches
+    tris.erase(tris.begin() + first, tris.end());
+    int created = 0;
+
+    for (int l = 0; l < holes; l++)
+    {
+        for (int v = fixed[l]; v < points[l].size(); v++)
+        {
+            originals[l].push_back(vertices->size());
+            vertices->push_back(points[l][v]);
+            created++;
+        }
+
+        for (int i = 0; i + 2 < triangles[l].size(); i += 3)
+        {
+            tris.push_back(vvr::Triangle(vertices, originals[l][triangles[l][i]],
+                originals[l][triangles[l][i + 1]], originals[l][triangles[l][i + 2]]));
+        }
+
+        patch_ends[l] = tris.size();
+    }
+
+    return created;
+}
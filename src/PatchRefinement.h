@@ -0,0 +1,21 @@
+#pragma once
+
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include <vector>
+
+// Pykn8wsh twn trigwnwn tou gemismatos wste na plhsiazoun thn pyknothta
+// tou montelou gyrw apo thn oph (opws ston Liepa).
+// Ka8e koryfh exei mia klimaka: oi koryfes ths ophs pairnoun to meso mhkos
+// twn akmwn ths ophs pou katalhgoun se aytes kai oi nees koryfes to meso oro
+// tou trigwnou pou xwrisan. Ena trigwno xwrizetai sto kentro baroys tou
+// otan apexei perissotero apo klimaka / REFINE_ALPHA apo oles tis koryfes,
+// kai meta oi akmes xalarwnoun me edge flips.
+// H geitniash krataeitai topika sto patch kai allazei se ka8e split/flip,
+// opote to kostos einai analogo tou mege8ous tou patch.
+#define REFINE_ALPHA 1.41421356f
+#define REFINE_MAX_ROUNDS 16
+
+// Synarthseis pykn8wshs
+int RefinePatch(std::vector<vec>& points, int fixed, std::vector<int>& triangles);
+int RefineHoles(std::vector<vvr::Triangle>& tris, int first, std::vector<int>& patch_ends);
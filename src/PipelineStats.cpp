@@ -0,0 +1,289 @@
+#include "PipelineStats.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+using namespace std;
+
+// Megisto plh8os trace events pou kratountai (ta palaiotera antika8istantai)
+#define TRACE_MAX_EVENTS   65536
+
+// Events pou krataei ka8e thread prin ta perasei sta koina
+#define TRACE_FLUSH_EVENTS 64
+
+int stats_enabled = 0;
+
+static const char* STAT_NAMES[STAT_COUNT] = {
+    "aabb_tests", "tritri_calls", "prefilter_rejects", "plane_rejects",
+    "coplanar_hits", "teeth_iterations", "triangles_removed", "hole_edges",
+    "loose_edges", "cg_iterations", "orient_tests", "orient_exact"
+};
+
+// Metrhtes ana thread, wste ta threads tou pool na mhn syngrouontai
+// sthn idia cache line. To GetStat a8roizei ola ta blocks.
+// Ta trace events tou thread mazeyontai sto pending kai pernane sta koina
+// ana TRACE_FLUSH_EVENTS, opote to stats_mutex pairnetai spania
+struct StatBlock
+{
+    std::atomic<long long> counters[STAT_COUNT];
+    int thread;
+    std::mutex lock;
+    std::vector<TraceEvent> pending;
+};
+
+// Synolikos xronos kai klhseis enos stadiou (gia to PrintStats)
+struct TraceTotal
+{
+    std::string name;
+    double first_end_us;
+    double total_us;
+    int calls;
+};
+
+static std::mutex stats_mutex;
+static std::vector<StatBlock*> stats_blocks;
+static int stats_threads = 0;
+
+// Oi metrhtes twn threads pou teleiwsan kai h bash tou ResetStats
+static long long retired_counters[STAT_COUNT];
+static long long reset_base[STAT_COUNT];
+
+// Ta teleytaia TRACE_MAX_EVENTS events (kyklikos buffer) kai ta synola ana stadio
+static std::vector<TraceEvent> trace_events;
+static long long trace_pushed = 0;
+static std::vector<TraceTotal> trace_totals;
+static const std::chrono::steady_clock::time_point stats_epoch = std::chrono::steady_clock::now();
+
+// Pros8hkh events sta koina (me to stats_mutex kleidwmeno)
+static void PushTraceEvents(const vector<TraceEvent>& events)
+{
+    for (int e = 0; e < events.size(); e++)
+    {
+        if (trace_events.size() < TRACE_MAX_EVENTS) trace_events.push_back(events[e]);
+        else trace_events[trace_pushed % TRACE_MAX_EVENTS] = events[e];
+        trace_pushed++;
+
+        int n = 0;
+        while (n < trace_totals.size() && trace_totals[n].name != events[e].name) n++;
+
+        if (n == trace_totals.size())
+        {
+            TraceTotal total = { events[e].name, events[e].begin_us + events[e].dur_us, 0, 0 };
+            trace_totals.push_back(total);
+        }
+
+        trace_totals[n].first_end_us = min(trace_totals[n].first_end_us, events[e].begin_us + events[e].dur_us);
+        trace_totals[n].total_us += events[e].dur_us;
+        trace_totals[n].calls++;
+    }
+}
+
+// Ta pending events olwn twn threads sta koina (me to stats_mutex kleidwmeno)
+static void FlushAllTraceEvents()
+{
+    for (int b = 0; b < stats_blocks.size(); b++)
+    {
+        vector<TraceEvent> events;
+        {
+            lock_guard<mutex> guard(stats_blocks[b]->lock);
+            events.swap(stats_blocks[b]->pending);
+        }
+
+        PushTraceEvents(events);
+    }
+}
+
+// To block anhkei sto thread tou: otan to thread teleiwnei oi metrhtes tou
+// prostithentai stous retired_counters, ta events tou pernane sta koina
+// kai to block eley8erwnetai
+class StatBlockOwner
+{
+public:
+    StatBlockOwner() : block(0) {}
+
+    ~StatBlockOwner()
+    {
+        if (!block) return;
+
+        lock_guard<mutex> lock(stats_mutex);
+
+        for (int c = 0; c < STAT_COUNT; c++) retired_counters[c] += block->counters[c].load(memory_order_relaxed);
+        PushTraceEvents(block->pending);
+
+        stats_blocks.erase(std::find(stats_blocks.begin(), stats_blocks.end(), block));
+        delete block;
+    }
+
+    StatBlock* block;
+};
+
+static StatBlock* LocalBlock()
+{
+    thread_local StatBlockOwner owner;
+
+    if (!owner.block)
+    {
+        StatBlock* b = new StatBlock;
+        for (int c = 0; c < STAT_COUNT; c++) b->counters[c].store(0);
+
+        lock_guard<mutex> lock(stats_mutex);
+        b->thread = stats_threads++;
+        stats_blocks.push_back(b);
+        owner.block = b;
+    }
+
+    return owner.block;
+}
+
+void EnableStats(int enable)
+{
+    stats_enabled = enable;
+}
+
+// Oi metrhtes grafontai mono apo to thread tous, opote to ResetStats den tous
+// mhdenizei: krataei thn trexousa timh san bash kai to GetStat th afairei
+void ResetStats()
+{
+    lock_guard<mutex> lock(stats_mutex);
+
+    for (int c = 0; c < STAT_COUNT; c++)
+    {
+        reset_base[c] = retired_counters[c];
+        for (int b = 0; b < stats_blocks.size(); b++) reset_base[c] += stats_blocks[b]->counters[c].load(memory_order_relaxed);
+    }
+
+    for (int b = 0; b < stats_blocks.size(); b++)
+    {
+        lock_guard<mutex> guard(stats_blocks[b]->lock);
+        stats_blocks[b]->pending.clear();
+    }
+
+    trace_events.clear();
+    trace_pushed = 0;
+    trace_totals.clear();
+}
+
+void AddStat(int counter, long long n)
+{
+    // Mono to idio to thread grafei to block tou, opote den xreiazetai fetch_add
+    std::atomic<long long>& c = LocalBlock()->counters[counter];
+    c.store(c.load(memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+long long GetStat(int counter)
+{
+    lock_guard<mutex> lock(stats_mutex);
+
+    long long sum = retired_counters[counter] - reset_base[counter];
+    for (int b = 0; b < stats_blocks.size(); b++) sum += stats_blocks[b]->counters[counter].load(memory_order_relaxed);
+
+    return sum;
+}
+
+const char* StatName(int counter)
+{
+    return STAT_NAMES[counter];
+}
+
+// Xronos se microseconds apo thn arxh tou programmatos
+double StatNow()
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - stats_epoch).count();
+}
+
+void AddTraceEvent(const char* name, double begin_us, double end_us)
+{
+    StatBlock* block = LocalBlock();
+    TraceEvent e = { name, begin_us, end_us - begin_us, block->thread };
+
+    vector<TraceEvent> events;
+    {
+        lock_guard<mutex> guard(block->lock);
+        block->pending.push_back(e);
+        if (block->pending.size() < TRACE_FLUSH_EVENTS) return;
+
+        events.swap(block->pending);
+    }
+
+    lock_guard<mutex> lock(stats_mutex);
+    PushTraceEvents(events);
+}
+
+// Ta apo8hkeymena events me th seira pou perasan sta koina
+std::vector<TraceEvent> GetTraceEvents()
+{
+    lock_guard<mutex> lock(stats_mutex);
+    FlushAllTraceEvents();
+
+    if (trace_events.size() < TRACE_MAX_EVENTS) return trace_events;
+
+    vector<TraceEvent> events;
+    events.reserve(TRACE_MAX_EVENTS);
+
+    int first = trace_pushed % TRACE_MAX_EVENTS;
+    events.insert(events.end(), trace_events.begin() + first, trace_events.end());
+    events.insert(events.end(), trace_events.begin(), trace_events.begin() + first);
+
+    return events;
+}
+
+void PrintStats(std::ostream& out)
+{
+    for (int c = 0; c < STAT_COUNT; c++)
+        out << StatName(c) << ": " << GetStat(c) << endl;
+
+    // Pososto twn Orient3D pou den ta kalypse to fragma sfalmatos
+    if (GetStat(STAT_ORIENT_TESTS) > 0)
+        out << "orient_exact_rate: " << 100.0 * GetStat(STAT_ORIENT_EXACT) / GetStat(STAT_ORIENT_TESTS) << " %" << endl;
+
+    // Ta stadia pou trexoun polles fores (p.x. ana chunk) a8roizontai.
+    // Ta synola metrane ola ta events, akoma k an den xwrane ston buffer
+    vector<TraceTotal> totals;
+    long long dropped;
+    {
+        lock_guard<mutex> lock(stats_mutex);
+        FlushAllTraceEvents();
+        totals = trace_totals;
+        dropped = max(0LL, trace_pushed - TRACE_MAX_EVENTS);
+    }
+
+    // Me th seira pou teleiwse ka8e stadio thn prwth fora
+    sort(totals.begin(), totals.end(), [](const TraceTotal& a, const TraceTotal& b) { return a.first_end_us < b.first_end_us; });
+
+    for (int n = 0; n < totals.size(); n++)
+    {
+        out << totals[n].name << ": " << totals[n].total_us / 1000.0 << " ms";
+        if (totals[n].calls > 1) out << " (" << totals[n].calls << " calls)";
+        out << endl;
+    }
+
+    if (dropped > 0) out << "trace_dropped: " << dropped << endl;
+}
+
+// Apo8hkeysh se morfh Chrome trace event (chrome://tracing, Perfetto)
+// Ta stadia ginontai "X" events kai oi metrhtes ena "C" event sto telos
+void WriteTrace(const std::string& file)
+{
+    ofstream out(file.c_str());
+    if (!out) throw string("Cannot write ") + file;
+
+    vector<TraceEvent> events = GetTraceEvents();
+    double end_us = 0;
+
+    out << "{\"traceEvents\": [\n";
+
+    for (int e = 0; e < events.size(); e++)
+    {
+        out << "  {\"name\": \"" << events[e].name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << events[e].thread
+            << ", \"ts\": " << events[e].begin_us << ", \"dur\": " << events[e].dur_us << "},\n";
+
+        if (events[e].begin_us + events[e].dur_us > end_us) end_us = events[e].begin_us + events[e].dur_us;
+    }
+
+    out << "  {\"name\": \"counters\", \"ph\": \"C\", \"pid\": 1, \"tid\": 0, \"ts\": " << end_us << ", \"args\": {";
+    for (int c = 0; c < STAT_COUNT; c++)
+        out << (c ? ", " : "") << "\"" << StatName(c) << "\": " << GetStat(c);
+    out << "}}\n]}\n";
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Metrhtes twn stadiwn tou pipeline
+enum StatCounter
+{
+    STAT_AABB_TESTS,        // Elegxoi epikalypshs AABB (TestAABBs kai komboi BVH)
+    STAT_TRITRI_CALLS,      // Klhseis ths TestTriTri
+    STAT_PREFILTER_REJECTS, // Zeugh pou aporriptei to SIMD prefilter epipedwn
+    STAT_PLANE_REJECTS,     // TestTriTri pou stamatane ston elegxo twn epipedwn (Orient3D)
+    STAT_COPLANAR_HITS,     // Trigwna sto idio epipedo (eidikh periptwsh)
+    STAT_TEETH_ITERATIONS,  // Trigwna pou elegx8hkan sth lista ergasiwn tou Cleaning
+    STAT_TRIANGLES_REMOVED, // Trigwna pou afaire8hkan (collision kai teeth)
+    STAT_HOLE_EDGES,        // Akmes opwn pou bre8hkan
+    STAT_LOOSE_EDGES,       // Akmes opwn pou den mphkan se brogxo (SortEdges)
+    STAT_CG_ITERATIONS,     // Epanalhpseis tou conjugate gradient sto fairing
+    STAT_ORIENT_TESTS,      // Klhseis tou Orient3D
+    STAT_ORIENT_EXACT,      // Orient3D pou xreiasthkan akribh ypologismo
+    STAT_COUNT
+};
+
+// Xronometrhsh enos stadiou (Chrome trace event "X")
+struct TraceEvent
+{
+    const char* name;
+    double begin_us;
+    double dur_us;
+    int thread;
+};
+
+// Oi metrhtes sylegontai mono an stats_enabled != 0,
+// alliws ka8e shmeio metrhshs kostizei ena elegxo
+extern int stats_enabled;
+
+void EnableStats(int enable);
+void ResetStats();
+void AddStat(int counter, long long n);
+long long GetStat(int counter);
+const char* StatName(int counter);
+double StatNow();
+void AddTraceEvent(const char* name, double begin_us, double end_us);
+std::vector<TraceEvent> GetTraceEvents();
+void PrintStats(std::ostream& out);
+void WriteTrace(const std::string& file);
+
+#define STAT_ADD(counter, n) do { if (stats_enabled) AddStat(counter, n); } while (0)
+
+// Xronometrei to scope tou an ta stats einai energa
+class StatTimer
+{
+public:
+    explicit StatTimer(const char* name) : name(name), start(stats_enabled ? StatNow() : -1) {}
+    ~StatTimer() { if (start >= 0) AddTraceEvent(name, start, StatNow()); }
+
+private:
+    const char* name;
+    double start;
+};
@@ -0,0 +1,190 @@
+#include "RobustPredicates.h"
+#include "PipelineStats.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// // // // // //
+// Expansions
+// // // // // //
+
+// Ta expansions einai a8roismata apo doubles pou den epikalyptontai, me auksousa
+// seira megethous kai xwris mhdenika. To proshmo tous einai to proshmo tou teleytaiou
+
+// x + y = a + b akribws
+static void TwoSum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+// x + y = a * b akribws
+static void TwoProduct(double a, double b, double& x, double& y)
+{
+    x = a * b;
+    y = fma(a, b, -x);
+}
+
+// Megisto mhkos twn expansions tou Orient3DExact (192 oroi, opws ston kwdika tou Shewchuk):
+// diafores 2, ginomena 2x2 -> 8, elassones 16, ginomena 2x16 -> 64, a8roisma 3 x 64.
+// Ola ta expansions einai pinakes sto stack, xwris desmeysh mnhmhs
+#define EXPANSION_MAX 192
+
+// h = e + b (grow_expansion me afairesh mhdenikwn). Epistrefei to mhkos tou h (<= elen + 1)
+static int Grow(const double* e, int elen, double b, double* h)
+{
+    int hlen = 0;
+    double q = b;
+
+    for (int i = 0; i < elen; i++)
+    {
+        double sum, err;
+        TwoSum(q, e[i], sum, err);
+        if (err != 0) h[hlen++] = err;
+        q = sum;
+    }
+
+    if (q != 0 || hlen == 0) h[hlen++] = q;
+    return hlen;
+}
+
+// h = e + f (<= elen + flen oroi)
+static int Add(const double* e, int elen, const double* f, int flen, double* h)
+{
+    double tmp[EXPANSION_MAX];
+    double* src = h;
+    double* dst = tmp;
+
+    int hlen = elen;
+    for (int i = 0; i < elen; i++) h[i] = e[i];
+
+    for (int i = 0; i < flen; i++)
+    {
+        hlen = Grow(src, hlen, f[i], dst);
+        std::swap(src, dst);
+    }
+
+    if (src != h)
+        for (int i = 0; i < hlen; i++) h[i] = src[i];
+
+    return hlen;
+}
+
+// h = e * f (<= 2 * elen * flen oroi)
+static int Multiply(const double* e, int elen, const double* f, int flen, double* h)
+{
+    double tmp[EXPANSION_MAX];
+    int hlen = 1;
+    h[0] = 0;
+
+    for (int i = 0; i < elen; i++)
+    {
+        for (int j = 0; j < flen; j++)
+        {
+            double x, y;
+            TwoProduct(e[i], f[j], x, y);
+
+            int tlen = Grow(h, hlen, y, tmp);
+            hlen = Grow(tmp, tlen, x, h);
+        }
+    }
+
+    return hlen;
+}
+
+// e = a - b (<= 2 oroi)
+static int Difference(double a, double b, double* e)
+{
+    double x, y;
+    TwoSum(a, -b, x, y);
+
+    int elen = 0;
+    if (y != 0) e[elen++] = y;
+    e[elen++] = x;
+
+    return elen;
+}
+
+static int Sign(const double* e, int elen)
+{
+    for (int i = elen - 1; i >= 0; i--)
+    {
+        if (e[i] > 0) return 1;
+        if (e[i] < 0) return -1;
+    }
+
+    return 0;
+}
+
+// // // // // //
+// Orient3D
+// // // // // //
+
+// Akribhs ypologismos ths orizousas [a - d; b - d; c - d]
+// H orizousa einai -(d - a) . ((b - a) x (c - a)), opote to proshmo ths antistrefetai
+int Orient3DExact(const vec& a, const vec& b, const vec& c, const vec& d)
+{
+    double adx[2], ady[2], adz[2], bdx[2], bdy[2], bdz[2], cdx[2], cdy[2], cdz[2];
+    int adxlen = Difference(a.x, d.x, adx), adylen = Difference(a.y, d.y, ady), adzlen = Difference(a.z, d.z, adz);
+    int bdxlen = Difference(b.x, d.x, bdx), bdylen = Difference(b.y, d.y, bdy), bdzlen = Difference(b.z, d.z, bdz);
+    int cdxlen = Difference(c.x, d.x, cdx), cdylen = Difference(c.y, d.y, cdy), cdzlen = Difference(c.z, d.z, cdz);
+
+    // u x v gia mia syntetagmenh: p * q - r * s
+    auto minor = [](const double* p, int plen, const double* q, int qlen, const double* r, int rlen, const double* s, int slen, double* out) {
+        double pq[8], rs[8];
+        int pqlen = Multiply(p, plen, q, qlen, pq);
+        int rslen = Multiply(r, rlen, s, slen, rs);
+        for (int i = 0; i < rslen; i++) rs[i] = -rs[i];
+        return Add(pq, pqlen, rs, rslen, out);
+    };
+
+    double m1[16], m2[16], m3[16];
+    int m1len = minor(bdy, bdylen, cdz, cdzlen, bdz, bdzlen, cdy, cdylen, m1);
+    int m2len = minor(cdy, cdylen, adz, adzlen, cdz, cdzlen, ady, adylen, m2);
+    int m3len = minor(ady, adylen, bdz, bdzlen, adz, adzlen, bdy, bdylen, m3);
+
+    double t1[64], t2[64], t3[64];
+    int t1len = Multiply(adx, adxlen, m1, m1len, t1);
+    int t2len = Multiply(bdx, bdxlen, m2, m2len, t2);
+    int t3len = Multiply(cdx, cdxlen, m3, m3len, t3);
+
+    double sum[128], det[EXPANSION_MAX];
+    int sumlen = Add(t1, t1len, t2, t2len, sum);
+    int detlen = Add(sum, sumlen, t3, t3len, det);
+
+    return -Sign(det, detlen);
+}
+
+// Orient3D me fragma sfalmatos sto double kai akribh ypologismo mono an xreiazetai
+int Orient3D(const vec& a, const vec& b, const vec& c, const vec& d)
+{
+    STAT_ADD(STAT_ORIENT_TESTS, 1);
+
+    double adx = (double)a.x - d.x, ady = (double)a.y - d.y, adz = (double)a.z - d.z;
+    double bdx = (double)b.x - d.x, bdy = (double)b.y - d.y, bdz = (double)b.z - d.z;
+    double cdx = (double)c.x - d.x, cdy = (double)c.y - d.y, cdz = (double)c.z - d.z;
+
+    double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady, adxcdy = adx * cdy;
+    double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+    double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+
+    double permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * fabs(adz)
+                     + (fabs(cdxady) + fabs(adxcdy)) * fabs(bdz)
+                     + (fabs(adxbdy) + fabs(bdxady)) * fabs(cdz);
+
+    // o3derrboundA tou Shewchuk: (7 + 56 eps) eps, eps = 2^-53
+    // Kalyptei kai th stroggylopoihsh twn diaforwn
+    const double epsilon = 1.1102230246251565e-16;
+    const double bound = (7.0 + 56.0 * epsilon) * epsilon * permanent;
+
+    if (det > bound) return -1;
+    if (-det > bound) return 1;
+
+    STAT_ADD(STAT_ORIENT_EXACT, 1);
+    return Orient3DExact(a, b, c, d);
+}
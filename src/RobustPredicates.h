@@ -0,0 +1,15 @@
+#pragma once
+
+#include <MathGeoLib.h>
+
+// Prosarmostika kathgorhmata (opws ta orient3d tou Shewchuk).
+// To orient3d ypologizetai prwta se double me ena fragma sfalmatos: an to
+// apotelesma einai megalytero apo to fragma to proshmo einai swsto. Alliws
+// (sxedon sto idio epipedo) ypologizetai akribws me expansions (a8roismata
+// apo doubles xwris stroggylopoihsh). Oi metrhtes STAT_ORIENT_TESTS kai
+// STAT_ORIENT_EXACT dinoun to pososto twn elegxwn pou xreiasthkan akribeia.
+
+// Synarthseis kathgorhmatwn
+// +1 an to d einai pros to ka8eto (b - a) x (c - a), -1 apo thn allh meria, 0 sto epipedo
+int Orient3D(const vec& a, const vec& b, const vec& c, const vec& d);
+int Orient3DExact(const vec& a, const vec& b, const vec& c, const vec& d);
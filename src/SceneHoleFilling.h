@@ -1,25 +1,11 @@
-#include <VVRScene/canvas.h>
-#include <VVRScene/mesh.h>
+#include "HoleFilling.h"
+#include "HoleTriangulation.h"
+#include "ObjLoader.h"
 #include <VVRScene/settings.h>
-#include <VVRScene/utils.h>
-#include <MathGeoLib.h>
-#include <iostream>
-#include <fstream>
 #include <cstring>
-#include <string>
 #include <set>
 
-#define FLAG_SHOW_TRIANGLES  1
-#define FLAG_SHOW_WIRE       2
-#define FLAG_SHOW_SOLID      4
-#define FLAG_SHOW_NORMALS    8
-#define FLAG_CHANGE_OBJ     16
-#define FLAG_SHOW_AABB      32
-#define FLAG_ERASE          64
-#define FLAG_HIDE          128
-
 // Metablhtes elegxou
-int m_style_flag;
 int readyPart2;
 int keepObj;
 int disablePart1;
@@ -28,27 +14,6 @@ int disableHide;
 int enable_model1_mov;
 int holeFirstPass;
 
-// Synarthseis ylopoihshs project
-void SetUp(std::vector<vec>& vertices, const vec& shift);
-void Displace(std::vector<vec>& vertices, vvr::ArrowDir dir, int modif);
-void CalcAABB(std::vector<vec>& vertices, vvr::Box3D& aabb);
-void DrawAABB(vvr::Box3D m_aabb, int collide);
-int TestAABBs(vvr::Box3D aabb1, vvr::Box3D aabb2);
-int TestTriangles(std::vector<vvr::Triangle>& tri1, std::vector<vvr::Triangle>& tri2);
-int TestPlaneTriangle(vvr::Triangle tri, vec n, float d);
-vvr::LineSeg3D PlaneTriangleInter(vvr::Triangle tri, vec n, float d);
-int PointInTriangle(vvr::Triangle tri, vec p);
-int SegInTriangle(vvr::Triangle tri, vvr::LineSeg3D line);
-int TestTriTri(vvr::Triangle tri1, vvr::Triangle tri2);
-int CheckVecs(vec v1, vec v2);
-int CheckEdgeOfTri(vvr::Triangle t, vec v1, vec v2);
-int CountAdjacentTriangles(vvr::Triangle t, std::vector<vvr::Triangle>& tris, int t_index);
-int EraseTeeth(std::vector<vvr::Triangle>& tris);
-void Cleaning(std::vector<vvr::Triangle>& tris, int once);
-void FindHoleTriangles(std::vector<vvr::Triangle>& tris, std::vector<vvr::Triangle>& holes, int once);
-void FindHoleEdges(std::vector<vvr::Triangle>& model, std::vector<vvr::Triangle>& holes, std::vector<vvr::LineSeg3D>& edges, int once);
-void SortEdges(std::vector<vvr::LineSeg3D>& edges, std::vector<vvr::LineSeg3D>& sorted_edges, std::vector<int>& indices);
-
 class HoleFillingScene : public vvr::Scene
 {
 public:
@@ -58,23 +23,37 @@ public:
     void arrowEvent(vvr::ArrowDir dir, int modif) override;
 
     // Synarthseis ylopoihshs project
-    void DrawSetup(vvr::Mesh m_model);
+    void DrawSetup(vvr::Mesh& m_model);
     void PrintKeyboardShortcuts();
 
 private:
     void draw() override;
     void reset() override;
     void resize() override;
+    void Update();
+    void ResetModels();
+    void SaveKeptModel();
+    vvr::Mesh* KeptModel();
+    ModelTransform* KeptTransform();
 
 private:
     int areColliding;
+    int pipeline_dirty;
     vvr::Colour m_obj1_col, m_obj2_col;
     vvr::Mesh m_model_original_1, m_model_1;
     vvr::Mesh m_model_original_2, m_model_2;
     vvr::Mesh m_model_original_3, m_model_3;
     vvr::Box3D m_aabb_1, m_aabb_2, m_aabb_3;
+    vvr::Box3D m_local_aabb_1, m_local_aabb_2, m_local_aabb_3;
+    ModelTransform m_transform_1, m_transform_2, m_transform_3;
+    CollisionCache m_collision_cache_1, m_collision_cache_2, m_collision_cache_3;
+    int m_version_1, m_version_2, m_version_3;
+    std::vector<std::pair<int, int> > collision_hits;
     std::vector<vvr::Triangle> hole_tris;
+    EdgeAdjacency hole_adj;
     std::vector<vvr::LineSeg3D> hole_edges;
     std::vector<vvr::LineSeg3D> sorted_hole_edges;
     std::vector<int> hole_indices;
+    std::vector<vvr::Triangle> hole_patch;
+    std::vector<int> hole_patch_ends;
 };
\ No newline at end of file
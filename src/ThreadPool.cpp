@@ -0,0 +1,141 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+using namespace std;
+
+// To thread pou kalei thn ParallelFor douleyei ki ayto, san to teleytaio thread
+ThreadPool::ThreadPool(int threads)
+    : task(nullptr), remaining(0), generation(0), stop(false)
+{
+    if (threads <= 0) threads = std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+
+    queues.resize(threads);
+    for (int i = 0; i < threads; i++) locks.emplace_back(new std::mutex);
+
+    for (int i = 0; i < threads - 1; i++)
+        workers.push_back(std::thread(&ThreadPool::Worker, this, i));
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<std::mutex> lock(wake_mutex);
+        stop = true;
+    }
+    wake.notify_all();
+
+    for (int i = 0; i < workers.size(); i++) workers[i].join();
+}
+
+ThreadPool& ThreadPool::Global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::Worker(int id)
+{
+    unsigned seen = 0;
+
+    while (true)
+    {
+        {
+            unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait(lock, [&] { return stop || generation != seen; });
+            if (stop) return;
+            seen = generation;
+        }
+
+        RunBatches(id);
+    }
+}
+
+void ThreadPool::RunBatches(int id)
+{
+    Batch b;
+
+    while (remaining > 0)
+    {
+        if (!Pop(id, b) && !Steal(id, b)) break;
+
+        (*task)(id, b.begin, b.end);
+
+        if (--remaining == 0)
+        {
+            lock_guard<std::mutex> lock(wake_mutex);
+            done.notify_all();
+        }
+    }
+}
+
+// Apo thn arxh ths dikhs tou ouras
+bool ThreadPool::Pop(int id, Batch& b)
+{
+    lock_guard<std::mutex> lock(*locks[id]);
+    if (queues[id].empty()) return false;
+
+    b = queues[id].front();
+    queues[id].pop_front();
+    return true;
+}
+
+// Apo to telos twn ourwn twn allwn
+bool ThreadPool::Steal(int id, Batch& b)
+{
+    for (int k = 1; k < queues.size(); k++)
+    {
+        int victim = (id + k) % queues.size();
+
+        lock_guard<std::mutex> lock(*locks[victim]);
+        if (queues[victim].empty()) continue;
+
+        b = queues[victim].back();
+        queues[victim].pop_back();
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::ParallelFor(int count, int batch, const std::function<void(int, int, int)>& job)
+{
+    if (count <= 0) return;
+    if (batch <= 0) batch = 1;
+
+    lock_guard<std::mutex> job_lock(job_mutex);
+
+    // Ena thread h ligh douleia: ektelesh sto idio thread
+    if (queues.size() == 1 || count <= batch)
+    {
+        job(queues.size() - 1, 0, count);
+        return;
+    }
+
+    // To task kai to remaining grafontai prin mpoun ta batches stis oures,
+    // wste ena thread pou pairnei batch na blepei hdh to swsto task
+    int batches = (count + batch - 1) / batch;
+    task = &job;
+    remaining = batches;
+
+    // Synexomena batches se ka8e oura, wste to stealing na xreiazetai spania
+    int per_queue = (batches + queues.size() - 1) / queues.size();
+
+    for (int b = 0; b < batches; b++)
+    {
+        Batch range = { b * batch, std::min(count, (b + 1) * batch) };
+        lock_guard<std::mutex> lock(*locks[b / per_queue]);
+        queues[b / per_queue].push_back(range);
+    }
+
+    {
+        lock_guard<std::mutex> lock(wake_mutex);
+        generation++;
+    }
+    wake.notify_all();
+
+    RunBatches(queues.size() - 1);
+
+    unique_lock<std::mutex> lock(wake_mutex);
+    done.wait(lock, [&] { return remaining == 0; });
+}
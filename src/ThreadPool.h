@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool me work stealing: ka8e thread exei th dikh tou oura apo batches
+// kai otan adeiasei klebei apo to telos twn ourwn twn allwn.
+// To task pairnei (thread, begin, end), me thread se [0, Size()) gia topika dedomena.
+// Den epitrepetai klhsh ParallelFor mesa apo task tou idiou pool.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    int Size() const { return queues.size(); }
+    void ParallelFor(int count, int batch, const std::function<void(int, int, int)>& task);
+
+    static ThreadPool& Global();
+
+private:
+    struct Batch
+    {
+        int begin, end;
+    };
+
+    void Worker(int id);
+    void RunBatches(int id);
+    bool Pop(int id, Batch& b);
+    bool Steal(int id, Batch& b);
+
+    std::vector<std::thread> workers;
+    std::vector<std::deque<Batch> > queues;
+    std::vector<std::unique_ptr<std::mutex> > locks;
+
+    std::mutex job_mutex;
+    std::mutex wake_mutex;
+    std::condition_variable wake, done;
+
+    const std::function<void(int, int, int)>* task;
+    std::atomic<int> remaining;
+    unsigned generation;
+    bool stop;
+};
@@ -0,0 +1,382 @@
+#include "TriTriSimd.h"
+#include "TriangleBVH.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRITRI_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// O MSVC dexetai ta intrinsics xwris /arch, o gcc/clang 8elei target ana synarthsh
+#if defined(_MSC_VER)
+#define TRITRI_TARGET(x)
+#else
+#define TRITRI_TARGET(x) __attribute__((target(x)))
+#endif
+
+using namespace std;
+
+// To paketo me tis times twn ypopshfiwn trigwnwn, mia grammh ana pedio
+#define PACKET_WIDTH 16
+#define P_AX 0
+#define P_AY 1
+#define P_AZ 2
+#define P_BX 3
+#define P_BY 4
+#define P_BZ 5
+#define P_CX 6
+#define P_CY 7
+#define P_CZ 8
+#define P_NX 9
+#define P_NY 10
+#define P_NZ 11
+#define P_NPERM 12
+#define P_FIELDS 13
+
+// Ta stoixeia tou trigwnou i pou elegxetai me olo to paketo
+struct TriTriQuery
+{
+    float ax, ay, az, bx, by, bz, cx, cy, cz;
+    float nx, ny, nz;
+    float margin;
+    float tolerance;
+};
+
+typedef unsigned (*TriTriKernel)(const TriTriQuery& q, const float (*p)[PACKET_WIDTH], int count);
+
+// Ta dedomena tou trigwnou i (koryfes a, b, c) sto soa
+static void SetTriangleSoA(TriangleSoA& soa, int i, const vec& a, const vec& b, const vec& c)
+{
+    vec e1 = b - a;
+    vec e2 = c - a;
+    vec normal = Cross(e1, e2);
+
+    soa.ax[i] = a.x; soa.ay[i] = a.y; soa.az[i] = a.z;
+    soa.bx[i] = b.x; soa.by[i] = b.y; soa.bz[i] = b.z;
+    soa.cx[i] = c.x; soa.cy[i] = c.y; soa.cz[i] = c.z;
+    soa.nx[i] = normal.x; soa.ny[i] = normal.y; soa.nz[i] = normal.z;
+    soa.nperm[i] = fabs(e1.y * e2.z) + fabs(e1.z * e2.y) + fabs(e1.z * e2.x) + fabs(e1.x * e2.z) + fabs(e1.x * e2.y) + fabs(e1.y * e2.x);
+
+    Plane plane(a, b, c);
+    soa.px[i] = plane.normal.x; soa.py[i] = plane.normal.y; soa.pz[i] = plane.normal.z;
+    soa.pd[i] = plane.d;
+
+    vec v0 = b - a;
+    vec v1 = c - a;
+    soa.d00[i] = Dot(v0, v0);
+    soa.d01[i] = Dot(v0, v1);
+    soa.d11[i] = Dot(v1, v1);
+    soa.denom[i] = soa.d00[i] * soa.d11[i] - soa.d01[i] * soa.d01[i];
+
+    vec corners[3] = { a, b, c };
+    float min[3], max[3];
+    TriangleBounds(TriangleView(corners, 0, 1, 2), min, max);
+    soa.minx[i] = min[0]; soa.miny[i] = min[1]; soa.minz[i] = min[2];
+    soa.maxx[i] = max[0]; soa.maxy[i] = max[1]; soa.maxz[i] = max[2];
+
+    for (int k = 0; k < 3; k++)
+        soa.scale = std::max(soa.scale, std::max(fabs(a[k]), std::max(fabs(b[k]), fabs(c[k]))));
+}
+
+static void ResizeTriangleSoA(TriangleSoA& soa, int n)
+{
+    vector<float>* fields[] = { &soa.ax, &soa.ay, &soa.az, &soa.bx, &soa.by, &soa.bz, &soa.cx, &soa.cy, &soa.cz,
+        &soa.nx, &soa.ny, &soa.nz, &soa.nperm, &soa.px, &soa.py, &soa.pz, &soa.pd, &soa.d00, &soa.d01, &soa.d11, &soa.denom,
+        &soa.minx, &soa.miny, &soa.minz, &soa.maxx, &soa.maxy, &soa.maxz };
+    for (int f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) fields[f]->resize(n);
+
+    soa.scale = 0;
+}
+
+void BuildTriangleSoA(const MeshView& tris, TriangleSoA& soa)
+{
+    int n = tris.size();
+    ResizeTriangleSoA(soa, n);
+
+    for (int i = 0; i < n; i++)
+    {
+        TriangleView tri = tris[i];
+        SetTriangleSoA(soa, i, tri.v1(), tri.v2(), tri.v3());
+    }
+}
+
+// SoA gia n trigwna me tis koryfes tous synexomenes (3 ana trigwno)
+// Gia ta liga trigwna enos fyllou tou BVH, ta buffers tou soa ksanaxrhsimopoiountai
+void BuildTriangleSoA(const vec* corners, int n, TriangleSoA& soa)
+{
+    ResizeTriangleSoA(soa, n);
+
+    for (int i = 0; i < n; i++)
+        SetTriangleSoA(soa, i, corners[3 * i], corners[3 * i + 1], corners[3 * i + 2]);
+}
+
+// Peri8wrio apostashs apo to epipedo ana monada tou nperm.
+// H apostash d = n . (p - a) ypologizetai se float opws h orizousa tou Orient3D,
+// opote to sfalma ths einai to poly (7 + 56 u) u P, me u = 2^-24 kai P to a8roisma
+// twn |orwn| (to fragma tou Shewchuk gia to orient3d). Me |p - a| <= 2 scale
+// einai P <= nperm * 2 scale, kai me 8u anti gia 7u kalyptetai kai h stroggylopoihsh
+// tou nperm. An |d| > peri8wrio to proshmo einai idio me tou Orient3D, opote o SIMD
+// elegxos aporriptei mono zeugh pou aporriptei kai h TestTriTri, akoma kai gia
+// ekfylismena trigwna (ekei to nperm einai poly megalytero apo to |n|)
+float TriTriTolerance(const TriangleSoA& a, const TriangleSoA& b)
+{
+    return TriTriTolerance(std::max(a.scale, b.scale));
+}
+
+// To idio me to megisto |syntetagmenh| twn koryfwn kai twn 2 montelwn (scale)
+float TriTriTolerance(float scale)
+{
+    const float u = 5.9604645e-8f;
+    return 8.0f * u * 2.0f * scale;
+}
+
+// Scalar ekdosh tou kernel, idia me tis SIMD
+// Bit k = 1 an to zeugh me to trigwno k tou paketou xreiazetai plhrh elegxo
+static unsigned KernelScalar(const TriTriQuery& q, const float (*p)[PACKET_WIDTH], int count)
+{
+    unsigned mask = 0;
+
+    for (int k = 0; k < count; k++)
+    {
+        // Koryfes tou k ws pros to epipedo tou i
+        float d0 = q.nx * (p[P_AX][k] - q.ax) + q.ny * (p[P_AY][k] - q.ay) + q.nz * (p[P_AZ][k] - q.az);
+        float d1 = q.nx * (p[P_BX][k] - q.ax) + q.ny * (p[P_BY][k] - q.ay) + q.nz * (p[P_BZ][k] - q.az);
+        float d2 = q.nx * (p[P_CX][k] - q.ax) + q.ny * (p[P_CY][k] - q.ay) + q.nz * (p[P_CZ][k] - q.az);
+
+        int sep = (d0 > q.margin && d1 > q.margin && d2 > q.margin) || (d0 < -q.margin && d1 < -q.margin && d2 < -q.margin);
+
+        // Koryfes tou i ws pros to epipedo tou k
+        float m = q.tolerance * p[P_NPERM][k];
+        float e0 = p[P_NX][k] * (q.ax - p[P_AX][k]) + p[P_NY][k] * (q.ay - p[P_AY][k]) + p[P_NZ][k] * (q.az - p[P_AZ][k]);
+        float e1 = p[P_NX][k] * (q.bx - p[P_AX][k]) + p[P_NY][k] * (q.by - p[P_AY][k]) + p[P_NZ][k] * (q.bz - p[P_AZ][k]);
+        float e2 = p[P_NX][k] * (q.cx - p[P_AX][k]) + p[P_NY][k] * (q.cy - p[P_AY][k]) + p[P_NZ][k] * (q.cz - p[P_AZ][k]);
+
+        sep |= (e0 > m && e1 > m && e2 > m) || (e0 < -m && e1 < -m && e2 < -m);
+
+        if (!sep) mask |= 1u << k;
+    }
+
+    return mask;
+}
+
+#ifdef TRITRI_X86
+
+TRITRI_TARGET("sse2")
+static unsigned KernelSSE(const TriTriQuery& q, const float (*p)[PACKET_WIDTH], int count)
+{
+    unsigned mask = 0;
+
+    for (int k = 0; k < count; k += 4)
+    {
+        __m128 ax = _mm_loadu_ps(&p[P_AX][k]), ay = _mm_loadu_ps(&p[P_AY][k]), az = _mm_loadu_ps(&p[P_AZ][k]);
+        __m128 bx = _mm_loadu_ps(&p[P_BX][k]), by = _mm_loadu_ps(&p[P_BY][k]), bz = _mm_loadu_ps(&p[P_BZ][k]);
+        __m128 cx = _mm_loadu_ps(&p[P_CX][k]), cy = _mm_loadu_ps(&p[P_CY][k]), cz = _mm_loadu_ps(&p[P_CZ][k]);
+        __m128 nx = _mm_loadu_ps(&p[P_NX][k]), ny = _mm_loadu_ps(&p[P_NY][k]), nz = _mm_loadu_ps(&p[P_NZ][k]);
+
+        __m128 qax = _mm_set1_ps(q.ax), qay = _mm_set1_ps(q.ay), qaz = _mm_set1_ps(q.az);
+        __m128 qnx = _mm_set1_ps(q.nx), qny = _mm_set1_ps(q.ny), qnz = _mm_set1_ps(q.nz);
+
+        __m128 d0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qnx, _mm_sub_ps(ax, qax)), _mm_mul_ps(qny, _mm_sub_ps(ay, qay))), _mm_mul_ps(qnz, _mm_sub_ps(az, qaz)));
+        __m128 d1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qnx, _mm_sub_ps(bx, qax)), _mm_mul_ps(qny, _mm_sub_ps(by, qay))), _mm_mul_ps(qnz, _mm_sub_ps(bz, qaz)));
+        __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qnx, _mm_sub_ps(cx, qax)), _mm_mul_ps(qny, _mm_sub_ps(cy, qay))), _mm_mul_ps(qnz, _mm_sub_ps(cz, qaz)));
+
+        __m128 pm = _mm_set1_ps(q.margin), nm = _mm_set1_ps(-q.margin);
+        __m128 sep = _mm_or_ps(
+            _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(d0, pm), _mm_cmpgt_ps(d1, pm)), _mm_cmpgt_ps(d2, pm)),
+            _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(d0, nm), _mm_cmplt_ps(d1, nm)), _mm_cmplt_ps(d2, nm)));
+
+        __m128 m = _mm_mul_ps(_mm_set1_ps(q.tolerance), _mm_loadu_ps(&p[P_NPERM][k]));
+        __m128 mn = _mm_sub_ps(_mm_setzero_ps(), m);
+        __m128 e0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_sub_ps(qax, ax)), _mm_mul_ps(ny, _mm_sub_ps(qay, ay))), _mm_mul_ps(nz, _mm_sub_ps(qaz, az)));
+        __m128 e1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_sub_ps(_mm_set1_ps(q.bx), ax)), _mm_mul_ps(ny, _mm_sub_ps(_mm_set1_ps(q.by), ay))), _mm_mul_ps(nz, _mm_sub_ps(_mm_set1_ps(q.bz), az)));
+        __m128 e2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_sub_ps(_mm_set1_ps(q.cx), ax)), _mm_mul_ps(ny, _mm_sub_ps(_mm_set1_ps(q.cy), ay))), _mm_mul_ps(nz, _mm_sub_ps(_mm_set1_ps(q.cz), az)));
+
+        sep = _mm_or_ps(sep, _mm_or_ps(
+            _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(e0, m), _mm_cmpgt_ps(e1, m)), _mm_cmpgt_ps(e2, m)),
+            _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(e0, mn), _mm_cmplt_ps(e1, mn)), _mm_cmplt_ps(e2, mn))));
+
+        mask |= (unsigned)(~_mm_movemask_ps(sep) & 0xF) << k;
+    }
+
+    return mask & ((count < 32) ? ((1u << count) - 1) : ~0u);
+}
+
+TRITRI_TARGET("avx2")
+static unsigned KernelAVX2(const TriTriQuery& q, const float (*p)[PACKET_WIDTH], int count)
+{
+    unsigned mask = 0;
+
+    for (int k = 0; k < count; k += 8)
+    {
+        __m256 ax = _mm256_loadu_ps(&p[P_AX][k]), ay = _mm256_loadu_ps(&p[P_AY][k]), az = _mm256_loadu_ps(&p[P_AZ][k]);
+        __m256 bx = _mm256_loadu_ps(&p[P_BX][k]), by = _mm256_loadu_ps(&p[P_BY][k]), bz = _mm256_loadu_ps(&p[P_BZ][k]);
+        __m256 cx = _mm256_loadu_ps(&p[P_CX][k]), cy = _mm256_loadu_ps(&p[P_CY][k]), cz = _mm256_loadu_ps(&p[P_CZ][k]);
+        __m256 nx = _mm256_loadu_ps(&p[P_NX][k]), ny = _mm256_loadu_ps(&p[P_NY][k]), nz = _mm256_loadu_ps(&p[P_NZ][k]);
+
+        __m256 qax = _mm256_set1_ps(q.ax), qay = _mm256_set1_ps(q.ay), qaz = _mm256_set1_ps(q.az);
+        __m256 qnx = _mm256_set1_ps(q.nx), qny = _mm256_set1_ps(q.ny), qnz = _mm256_set1_ps(q.nz);
+
+        __m256 d0 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(qnx, _mm256_sub_ps(ax, qax)), _mm256_mul_ps(qny, _mm256_sub_ps(ay, qay))), _mm256_mul_ps(qnz, _mm256_sub_ps(az, qaz)));
+        __m256 d1 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(qnx, _mm256_sub_ps(bx, qax)), _mm256_mul_ps(qny, _mm256_sub_ps(by, qay))), _mm256_mul_ps(qnz, _mm256_sub_ps(bz, qaz)));
+        __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(qnx, _mm256_sub_ps(cx, qax)), _mm256_mul_ps(qny, _mm256_sub_ps(cy, qay))), _mm256_mul_ps(qnz, _mm256_sub_ps(cz, qaz)));
+
+        __m256 pm = _mm256_set1_ps(q.margin), nm = _mm256_set1_ps(-q.margin);
+        __m256 sep = _mm256_or_ps(
+            _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(d0, pm, _CMP_GT_OQ), _mm256_cmp_ps(d1, pm, _CMP_GT_OQ)), _mm256_cmp_ps(d2, pm, _CMP_GT_OQ)),
+            _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(d0, nm, _CMP_LT_OQ), _mm256_cmp_ps(d1, nm, _CMP_LT_OQ)), _mm256_cmp_ps(d2, nm, _CMP_LT_OQ)));
+
+        __m256 m = _mm256_mul_ps(_mm256_set1_ps(q.tolerance), _mm256_loadu_ps(&p[P_NPERM][k]));
+        __m256 mn = _mm256_sub_ps(_mm256_setzero_ps(), m);
+        __m256 e0 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, _mm256_sub_ps(qax, ax)), _mm256_mul_ps(ny, _mm256_sub_ps(qay, ay))), _mm256_mul_ps(nz, _mm256_sub_ps(qaz, az)));
+        __m256 e1 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, _mm256_sub_ps(_mm256_set1_ps(q.bx), ax)), _mm256_mul_ps(ny, _mm256_sub_ps(_mm256_set1_ps(q.by), ay))), _mm256_mul_ps(nz, _mm256_sub_ps(_mm256_set1_ps(q.bz), az)));
+        __m256 e2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, _mm256_sub_ps(_mm256_set1_ps(q.cx), ax)), _mm256_mul_ps(ny, _mm256_sub_ps(_mm256_set1_ps(q.cy), ay))), _mm256_mul_ps(nz, _mm256_sub_ps(_mm256_set1_ps(q.cz), az)));
+
+        sep = _mm256_or_ps(sep, _mm256_or_ps(
+            _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(e0, m, _CMP_GT_OQ), _mm256_cmp_ps(e1, m, _CMP_GT_OQ)), _mm256_cmp_ps(e2, m, _CMP_GT_OQ)),
+            _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(e0, mn, _CMP_LT_OQ), _mm256_cmp_ps(e1, mn, _CMP_LT_OQ)), _mm256_cmp_ps(e2, mn, _CMP_LT_OQ))));
+
+        mask |= (unsigned)(~_mm256_movemask_ps(sep) & 0xFF) << k;
+    }
+
+    return mask & ((count < 32) ? ((1u << count) - 1) : ~0u);
+}
+
+TRITRI_TARGET("avx512f")
+static unsigned KernelAVX512(const TriTriQuery& q, const float (*p)[PACKET_WIDTH], int count)
+{
+    __m512 ax = _mm512_loadu_ps(p[P_AX]), ay = _mm512_loadu_ps(p[P_AY]), az = _mm512_loadu_ps(p[P_AZ]);
+    __m512 bx = _mm512_loadu_ps(p[P_BX]), by = _mm512_loadu_ps(p[P_BY]), bz = _mm512_loadu_ps(p[P_BZ]);
+    __m512 cx = _mm512_loadu_ps(p[P_CX]), cy = _mm512_loadu_ps(p[P_CY]), cz = _mm512_loadu_ps(p[P_CZ]);
+    __m512 nx = _mm512_loadu_ps(p[P_NX]), ny = _mm512_loadu_ps(p[P_NY]), nz = _mm512_loadu_ps(p[P_NZ]);
+
+    __m512 qax = _mm512_set1_ps(q.ax), qay = _mm512_set1_ps(q.ay), qaz = _mm512_set1_ps(q.az);
+    __m512 qnx = _mm512_set1_ps(q.nx), qny = _mm512_set1_ps(q.ny), qnz = _mm512_set1_ps(q.nz);
+
+    __m512 d0 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(qnx, _mm512_sub_ps(ax, qax)), _mm512_mul_ps(qny, _mm512_sub_ps(ay, qay))), _mm512_mul_ps(qnz, _mm512_sub_ps(az, qaz)));
+    __m512 d1 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(qnx, _mm512_sub_ps(bx, qax)), _mm512_mul_ps(qny, _mm512_sub_ps(by, qay))), _mm512_mul_ps(qnz, _mm512_sub_ps(bz, qaz)));
+    __m512 d2 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(qnx, _mm512_sub_ps(cx, qax)), _mm512_mul_ps(qny, _mm512_sub_ps(cy, qay))), _mm512_mul_ps(qnz, _mm512_sub_ps(cz, qaz)));
+
+    __m512 pm = _mm512_set1_ps(q.margin), nm = _mm512_set1_ps(-q.margin);
+    __mmask16 sep =
+        (_mm512_cmp_ps_mask(d0, pm, _CMP_GT_OQ) & _mm512_cmp_ps_mask(d1, pm, _CMP_GT_OQ) & _mm512_cmp_ps_mask(d2, pm, _CMP_GT_OQ)) |
+        (_mm512_cmp_ps_mask(d0, nm, _CMP_LT_OQ) & _mm512_cmp_ps_mask(d1, nm, _CMP_LT_OQ) & _mm512_cmp_ps_mask(d2, nm, _CMP_LT_OQ));
+
+    __m512 m = _mm512_mul_ps(_mm512_set1_ps(q.tolerance), _mm512_loadu_ps(p[P_NPERM]));
+    __m512 mn = _mm512_sub_ps(_mm512_setzero_ps(), m);
+    __m512 e0 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(nx, _mm512_sub_ps(qax, ax)), _mm512_mul_ps(ny, _mm512_sub_ps(qay, ay))), _mm512_mul_ps(nz, _mm512_sub_ps(qaz, az)));
+    __m512 e1 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(nx, _mm512_sub_ps(_mm512_set1_ps(q.bx), ax)), _mm512_mul_ps(ny, _mm512_sub_ps(_mm512_set1_ps(q.by), ay))), _mm512_mul_ps(nz, _mm512_sub_ps(_mm512_set1_ps(q.bz), az)));
+    __m512 e2 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(nx, _mm512_sub_ps(_mm512_set1_ps(q.cx), ax)), _mm512_mul_ps(ny, _mm512_sub_ps(_mm512_set1_ps(q.cy), ay))), _mm512_mul_ps(nz, _mm512_sub_ps(_mm512_set1_ps(q.cz), az)));
+
+    sep |=
+        (_mm512_cmp_ps_mask(e0, m, _CMP_GT_OQ) & _mm512_cmp_ps_mask(e1, m, _CMP_GT_OQ) & _mm512_cmp_ps_mask(e2, m, _CMP_GT_OQ)) |
+        (_mm512_cmp_ps_mask(e0, mn, _CMP_LT_OQ) & _mm512_cmp_ps_mask(e1, mn, _CMP_LT_OQ) & _mm512_cmp_ps_mask(e2, mn, _CMP_LT_OQ));
+
+    return (unsigned)(~sep & 0xFFFF) & ((1u << count) - 1);
+}
+
+#endif
+
+// Eyresh tou kalyterou set entolwn pou yposthrizei o epe3ergasths
+int DetectSimdLevel()
+{
+#ifdef TRITRI_X86
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    int osxsave = (info[2] >> 27) & 1;
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+    int avx2 = 0, avx512 = 0;
+    if (max_leaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] >> 5) & 1;
+        avx512 = (info[1] >> 16) & 1;
+    }
+
+    if (avx512 && (xcr0 & 0xE6) == 0xE6) return SIMD_AVX512;
+    if (avx2 && (xcr0 & 0x6) == 0x6) return SIMD_AVX2;
+    return SIMD_SSE;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse2")) return SIMD_SSE;
+#endif
+#endif
+    return SIMD_SCALAR;
+}
+
+// To epipedo diabazetai apo ta threads tou pool: h arxikopoihsh tou static
+// ginetai mia fora (thread-safe sto C++11) kai oi allages einai atomikes
+static std::atomic<int>& TriTriLevel()
+{
+    static std::atomic<int> level(DetectSimdLevel());
+    return level;
+}
+
+int GetTriTriLevel()
+{
+    return TriTriLevel().load(std::memory_order_relaxed);
+}
+
+// Epilogh kernel (px gia sygkrish), oxi panw apo ayto pou yposthrizetai
+void SetTriTriLevel(int level)
+{
+    TriTriLevel().store(std::max(SIMD_SCALAR, std::min(level, DetectSimdLevel())), std::memory_order_relaxed);
+}
+
+static TriTriKernel SelectKernel(int level)
+{
+#ifdef TRITRI_X86
+    if (level == SIMD_AVX512) return KernelAVX512;
+    if (level == SIMD_AVX2) return KernelAVX2;
+    if (level == SIMD_SSE) return KernelSSE;
+#endif
+    return KernelScalar;
+}
+
+// Aporripsh twn ypopshfiwn trigwnwn tou b pou xwrizontai apo to trigwno i tou a
+// me ena apo ta dyo epipeda. Ta ypoloipa grafontai sto out gia plhrh elegxo
+// me thn TestTriTri. Epistrefei to plh8os tous
+int FilterTriTri(const TriangleSoA& a, int i, const TriangleSoA& b, const int* candidates, int count, float tolerance, int* out)
+{
+    TriTriKernel kernel = SelectKernel(GetTriTriLevel());
+
+    TriTriQuery q;
+    q.ax = a.ax[i]; q.ay = a.ay[i]; q.az = a.az[i];
+    q.bx = a.bx[i]; q.by = a.by[i]; q.bz = a.bz[i];
+    q.cx = a.cx[i]; q.cy = a.cy[i]; q.cz = a.cz[i];
+    q.nx = a.nx[i]; q.ny = a.ny[i]; q.nz = a.nz[i];
+    q.margin = tolerance * a.nperm[i];
+    q.tolerance = tolerance;
+
+    const vector<float>* fields[P_FIELDS] = { &b.ax, &b.ay, &b.az, &b.bx, &b.by, &b.bz, &b.cx, &b.cy, &b.cz, &b.nx, &b.ny, &b.nz, &b.nperm };
+    float packet[P_FIELDS][PACKET_WIDTH];
+    int n = 0;
+
+    for (int first = 0; first < count; first += PACKET_WIDTH)
+    {
+        int size = std::min(PACKET_WIDTH, count - first);
+
+        // Syllogh twn ypopshfiwn sto paketo, ta kena gemizoun me to teleytaio
+        for (int f = 0; f < P_FIELDS; f++)
+            for (int k = 0; k < PACKET_WIDTH; k++)
+                packet[f][k] = (*fields[f])[candidates[first + std::min(k, size - 1)]];
+
+        unsigned mask = kernel(q, packet, size);
+
+        for (int k = 0; k < size; k++)
+            if (mask & (1u << k)) out[n++] = candidates[first + k];
+    }
+
+    return n;
+}
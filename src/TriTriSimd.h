@@ -0,0 +1,39 @@
+#pragma once
+
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include "MeshView.h"
+#include <vector>
+
+#define SIMD_SCALAR  0
+#define SIMD_SSE     1
+#define SIMD_AVX2    2
+#define SIMD_AVX512  3
+
+// Dedomena trigwnwn se morfh SoA gia ton elegxo se paketa
+// To n einai to mh kanonikopoihmeno ka8eto (b - a) x (c - a) kai nperm to a8roisma
+// twn |orwn| twn syntetagmenwn tou (gia to fragma sfalmatos tou TriTriTolerance).
+// Gia to narrow phase kratountai kai ta paragomena dedomena ka8e trigwnou:
+// to epipedo (p monadiaio ka8eto kai pd, opws sto Plane), h barycentrikh bash
+// tou PointInTriangle (d00, d01, d11, denom) kai to AABB (opws sto TriangleBounds)
+struct TriangleSoA
+{
+    std::vector<float> ax, ay, az;
+    std::vector<float> bx, by, bz;
+    std::vector<float> cx, cy, cz;
+    std::vector<float> nx, ny, nz, nperm;
+    std::vector<float> px, py, pz, pd;
+    std::vector<float> d00, d01, d11, denom;
+    std::vector<float> minx, miny, minz, maxx, maxy, maxz;
+    float scale;
+};
+
+// Synarthseis SIMD elegxou
+void BuildTriangleSoA(const MeshView& tris, TriangleSoA& soa);
+void BuildTriangleSoA(const vec* corners, int n, TriangleSoA& soa);
+float TriTriTolerance(const TriangleSoA& a, const TriangleSoA& b);
+float TriTriTolerance(float scale);
+int DetectSimdLevel();
+int GetTriTriLevel();
+void SetTriTriLevel(int level);
+int FilterTriTri(const TriangleSoA& a, int i, const TriangleSoA& b, const int* candidates, int count, float tolerance, int* out);
@@ -0,0 +1,205 @@
+#include "TriangleBVH.h"
+#include "PipelineStats.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// Megisto plh8os trigwnwn se ka8e fyllo
+#define BVH_LEAF_SIZE 4
+
+// Mikro peri8wrio gia na mh xanontai trigwna pou akoumpane
+#define BVH_EPSILON 1e-5f
+
+// Ypologismos AABB enos trigwnou
+void TriangleBounds(const TriangleView& tri, float min[3], float max[3])
+{
+    const vec& a = tri.v1();
+    const vec& b = tri.v2();
+    const vec& c = tri.v3();
+
+    for (int k = 0; k < 3; k++)
+    {
+        min[k] = std::min(a[k], std::min(b[k], c[k]));
+        max[k] = std::max(a[k], std::max(b[k], c[k]));
+
+        float pad = BVH_EPSILON * (1.0f + std::max(fabs(min[k]), fabs(max[k])));
+        min[k] -= pad;
+        max[k] += pad;
+    }
+}
+
+// Anadromikh kataskeyh kombou gia ta tri_ids[first..last)
+static int BuildNode(TriangleBVH& bvh, vector<float>& bounds, vector<float>& centers, int first, int last)
+{
+    BVHNode node;
+    node.left = node.right = -1;
+    node.first = first;
+    node.count = 0;
+
+    for (int k = 0; k < 3; k++)
+    {
+        node.min[k] = bounds[6 * bvh.tri_ids[first] + k];
+        node.max[k] = bounds[6 * bvh.tri_ids[first] + 3 + k];
+    }
+
+    float cmin[3] = { centers[3 * bvh.tri_ids[first]], centers[3 * bvh.tri_ids[first] + 1], centers[3 * bvh.tri_ids[first] + 2] };
+    float cmax[3] = { cmin[0], cmin[1], cmin[2] };
+
+    for (int i = first; i < last; i++)
+    {
+        int t = bvh.tri_ids[i];
+
+        for (int k = 0; k < 3; k++)
+        {
+            node.min[k] = std::min(node.min[k], bounds[6 * t + k]);
+            node.max[k] = std::max(node.max[k], bounds[6 * t + 3 + k]);
+            cmin[k] = std::min(cmin[k], centers[3 * t + k]);
+            cmax[k] = std::max(cmax[k], centers[3 * t + k]);
+        }
+    }
+
+    int index = bvh.nodes.size();
+    bvh.nodes.push_back(node);
+
+    // Fyllo
+    if (last - first <= BVH_LEAF_SIZE)
+    {
+        bvh.nodes[index].count = last - first;
+        return index;
+    }
+
+    // Diaxwrismos sth mesh tou megalyterou a3ona twn kentrwn
+    int axis = 0;
+    if (cmax[1] - cmin[1] > cmax[axis] - cmin[axis]) axis = 1;
+    if (cmax[2] - cmin[2] > cmax[axis] - cmin[axis]) axis = 2;
+
+    int mid = (first + last) / 2;
+    nth_element(bvh.tri_ids.begin() + first, bvh.tri_ids.begin() + mid, bvh.tri_ids.begin() + last,
+        [&centers, axis](int a, int b) { return centers[3 * a + axis] < centers[3 * b + axis]; });
+
+    int left = BuildNode(bvh, bounds, centers, first, mid);
+    int right = BuildNode(bvh, bounds, centers, mid, last);
+    bvh.nodes[index].left = left;
+    bvh.nodes[index].right = right;
+
+    return index;
+}
+
+// Kataskeyh BVH gia ola ta trigwna tou montelou
+void BuildBVH(const MeshView& tris, TriangleBVH& bvh)
+{
+    bvh.nodes.clear();
+    bvh.tri_ids.resize(tris.size());
+
+    if (tris.empty()) return;
+
+    vector<float> bounds(6 * tris.size());
+    vector<float> centers(3 * tris.size());
+
+    for (int i = 0; i < tris.size(); i++)
+    {
+        bvh.tri_ids[i] = i;
+        TriangleBounds(tris[i], &bounds[6 * i], &bounds[6 * i + 3]);
+
+        for (int k = 0; k < 3; k++)
+            centers[3 * i + k] = 0.5f * (bounds[6 * i + k] + bounds[6 * i + 3 + k]);
+    }
+
+    bvh.nodes.reserve(2 * tris.size() / BVH_LEAF_SIZE + 1);
+    BuildNode(bvh, bounds, centers, 0, tris.size());
+}
+
+// Epistrefei ta trigwna twn opoiwn to AABB temnei to dosmeno AABB
+void QueryBVH(const TriangleBVH& bvh, const float min[3], const float max[3], vector<int>& result)
+{
+    result.clear();
+
+    if (bvh.nodes.empty()) return;
+
+    int stack[64];
+    int top = 0;
+    int tests = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const BVHNode& node = bvh.nodes[stack[--top]];
+        tests++;
+
+        // Den yparxei tomh an den yparxei epikalypsh se kapoion a3ona
+        if (node.max[0] < min[0] || node.min[0] > max[0]) continue;
+        if (node.max[1] < min[1] || node.min[1] > max[1]) continue;
+        if (node.max[2] < min[2] || node.min[2] > max[2]) continue;
+
+        if (node.count > 0)
+        {
+            for (int i = node.first; i < node.first + node.count; i++)
+                result.push_back(bvh.tri_ids[i]);
+        }
+        else
+        {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+
+    STAT_ADD(STAT_AABB_TESTS, tests);
+}
+
+// Opws h QueryBVH, gia to BVH metasxhmatismeno me p' = rotation * p + translation.
+// To AABB ka8e kombou metaferetai sto systhma tou erwthmatos (to kentro tou kai
+// hmi-diastaseis |R| * e), opote to dentro den 3anaftiaxnetai otan kineitai to montelo.
+// Epistrefei tous kombous-fylla pou temnoun to dosmeno AABB
+void QueryBVHLeaves(const TriangleBVH& bvh, const float rotation[3][3], const vec& translation,
+    const float min[3], const float max[3], vector<int>& leaves)
+{
+    leaves.clear();
+
+    if (bvh.nodes.empty()) return;
+
+    int stack[64];
+    int top = 0;
+    int tests = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        int index = stack[--top];
+        const BVHNode& node = bvh.nodes[index];
+        tests++;
+
+        int overlap = 1;
+        for (int i = 0; i < 3 && overlap; i++)
+        {
+            const float* r = rotation[i];
+            float c = translation[i], e = 0;
+
+            for (int k = 0; k < 3; k++)
+            {
+                c += r[k] * 0.5f * (node.min[k] + node.max[k]);
+                e += fabs(r[k]) * 0.5f * (node.max[k] - node.min[k]);
+            }
+
+            // Peri8wrio gia th stroggylopoihsh tou metasxhmatismou (opws sto TriangleBounds)
+            e += BVH_EPSILON * (1.0f + fabs(c) + e);
+
+            // Den yparxei tomh an den yparxei epikalypsh se kapoion a3ona
+            if (c + e < min[i] || c - e > max[i]) overlap = 0;
+        }
+
+        if (!overlap) continue;
+
+        if (node.count > 0)
+        {
+            leaves.push_back(index);
+        }
+        else
+        {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+
+    STAT_ADD(STAT_AABB_TESTS, tests);
+}
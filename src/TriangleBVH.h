@@ -0,0 +1,29 @@
+#pragma once
+
+#include <VVRScene/mesh.h>
+#include <MathGeoLib.h>
+#include "MeshView.h"
+#include <vector>
+
+// Kombos tou dentrou AABB (BVH) twn trigwnwn enos montelou
+// Ta fylla exoun count > 0 kai deixnoun sto tri_ids[first..first+count)
+struct BVHNode
+{
+    float min[3];
+    float max[3];
+    int left, right;
+    int first, count;
+};
+
+struct TriangleBVH
+{
+    std::vector<BVHNode> nodes;
+    std::vector<int> tri_ids;
+};
+
+// Synarthseis BVH
+void TriangleBounds(const TriangleView& tri, float min[3], float max[3]);
+void BuildBVH(const MeshView& tris, TriangleBVH& bvh);
+void QueryBVH(const TriangleBVH& bvh, const float min[3], const float max[3], std::vector<int>& result);
+void QueryBVHLeaves(const TriangleBVH& bvh, const float rotation[3][3], const vec& translation,
+    const float min[3], const float max[3], std::vector<int>& leaves);
@@ -0,0 +1,96 @@
+#include "HoleFilling.h"
+#include "HoleTriangulation.h"
+#include "ObjLoader.h"
+
+using namespace std;
+
+// Montela tou resources/obj pou einai manifold prin to gemisma
+static const char* TEST_MODELS[] = { "bunny_low", "armadillo_low_low", "suzanne" };
+
+#define TEST_MODEL_COUNT (sizeof(TEST_MODELS) / sizeof(TEST_MODELS[0]))
+
+// Akmes me perissotera apo 2 trigwna kai akmes pou exoun thn idia fora se 2 trigwna
+static void CountBadEdges(vector<vvr::Triangle>& tris, int& non_manifold, int& duplicate)
+{
+    EdgeAdjacency adj;
+    BuildEdgeAdjacency(tris, adj);
+
+    non_manifold = 0;
+    duplicate = 0;
+
+    for (int e = 0; e + 1 < adj.edge_offsets.size(); e++)
+    {
+        int begin = adj.edge_offsets[e], end = adj.edge_offsets[e + 1];
+        if (end - begin > 2) non_manifold++;
+
+        // H fora ths akmhs sto prwto trigwno kai posa trigwna thn exoun idia
+        int f = adj.edge_faces[begin];
+        int k = 0;
+        while (adj.face_edges[3 * f + k] != e) k++;
+
+        uint32_t a = adj.face_vertices[3 * f + k], b = adj.face_vertices[3 * f + (k + 1) % 3];
+        int forward = 0;
+
+        for (int j = begin; j < end; j++)
+        {
+            const uint32_t* v = &adj.face_vertices[3 * adj.edge_faces[j]];
+
+            for (int m = 0; m < 3; m++)
+                if (v[m] == a && v[(m + 1) % 3] == b) forward++;
+        }
+
+        if (forward > 1 || end - begin - forward > 1) duplicate++;
+    }
+}
+
+// Elegxos oti to --fill den kanei non-manifold ena manifold montelo
+// Epistrefei 0 an ola ta montela perasan
+int main(int argc, char* argv[])
+{
+    string dir = (argc > 1) ? argv[1] : "resources/obj/";
+    if (!dir.empty() && dir[dir.size() - 1] != '/' && dir[dir.size() - 1] != '\\') dir += "/";
+
+    m_style_flag = FLAG_ERASE;
+    int failed = 0;
+
+    try {
+        for (int m = 0; m < TEST_MODEL_COUNT; m++)
+        {
+            vvr::Mesh model_1, model_2;
+            LoadObj(dir + TEST_MODELS[m] + ".obj", model_1, 0, 0);
+            LoadObj(dir + TEST_MODELS[m] + ".obj", model_2, 0, 0);
+
+            SetUp(model_1.getVertices(), vec(0.1f, 0.05f, 0));
+            SetUp(model_2.getVertices(), vec(-0.1f, 0, 0));
+
+            vector<vvr::LineSeg3D> edges, loops;
+            vector<int> loop_ends, patch_ends;
+            PipelineTimes times;
+            RunPipeline(model_1, model_2, 1, edges, loops, loop_ends, times);
+
+            vector<vvr::Triangle>& tris = model_1.getTriangles();
+            int cleaned_non_manifold, cleaned_duplicate;
+            CountBadEdges(tris, cleaned_non_manifold, cleaned_duplicate);
+
+            EdgeAdjacency adj;
+            BuildEdgeAdjacency(tris, adj);
+            FillHoles(tris, adj, loops, loop_ends, patch_ends);
+
+            int non_manifold, duplicate;
+            CountBadEdges(tris, non_manifold, duplicate);
+
+            int ok = cleaned_non_manifold == 0 && cleaned_duplicate == 0 && non_manifold == 0 && duplicate == 0;
+            failed += !ok;
+
+            cout << TEST_MODELS[m] << ": " << (ok ? "ok" : "FAILED")
+                << " (non-manifold " << cleaned_non_manifold << " -> " << non_manifold
+                << ", duplicate directed " << cleaned_duplicate << " -> " << duplicate << ")" << endl;
+        }
+    }
+    catch (std::string exc) {
+        cerr << exc << endl;
+        return 1;
+    }
+
+    return failed ? 1 : 0;
+}